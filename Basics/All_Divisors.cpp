@@ -1,4 +1,24 @@
 #include <bits/stdc++.h>
+#include "../bench.h"
+
+/*
+========================================
+ DIVISORS
+----------------------------------------
+ divisors(n)      : one number, O(sqrt n) trial loop into a std::set
+ DivisorTable     : many numbers
+   - a linear sieve fills spf[n] (smallest prime factor) for every
+     n <= limit once, O(limit)
+   - divisors of n come from its factorization (walk spf), written
+     into a caller-provided buffer and sorted in place:
+     no allocation per call
+   - forEachRange() spreads a range over threads, each with its own
+     buffer
+
+ ./All_Divisors               -> divisors of 12
+ ./All_Divisors bench [N]     -> every n in [1, N] (default 1e7)
+========================================
+*/
 
 std::set<int> divisors(int n) {
     int temp = n;
@@ -9,11 +29,151 @@ std::set<int> divisors(int n) {
         v.insert(n / i);
     }
 }
-    // v.push_back(temp);       
+    // v.push_back(temp);
     return v;
-} 
-    
-int main(){
+}
+
+class DivisorTable {
+public:
+    // no int has more divisors than this (1600, for 2095133040)
+    static const int MAX_DIVISORS = 1600;
+
+    explicit DivisorTable(int limit) : spf(limit + 1, 0) {
+        std::vector<int> primes;
+        for (int i = 2; i <= limit; i++) {
+            if (spf[i] == 0) {
+                spf[i] = i;
+                primes.push_back(i);
+            }
+            // every composite is crossed exactly once, by its spf
+            for (int p : primes) {
+                if (p > spf[i] || (long long)p * i > limit) break;
+                spf[p * i] = p;
+            }
+        }
+    }
+
+    int limit() const { return (int)spf.size() - 1; }
+
+    /*
+     Sorted divisors of n (1 <= n <= limit()) into out, which must hold
+     MAX_DIVISORS ints. Returns how many were written.
+    */
+    int divisors(int n, int* out) const {
+        int count = 1;
+        out[0] = 1;
+        while (n > 1) {
+            int p = spf[n], e = 0;
+            while (n % p == 0) {
+                n /= p;
+                e++;
+            }
+            // multiply the divisors so far by p, p^2, .., p^e
+            // (pk only grows up to p^e <= n, so it never overflows)
+            int base = count;
+            for (int k = 0, pk = 1; k < e; k++) {
+                pk *= p;
+                for (int i = 0; i < base; i++) out[count++] = out[i] * pk;
+            }
+        }
+        if (count <= 32) {
+            // small lists: insertion sort beats std::sort's setup
+            for (int i = 1; i < count; i++) {
+                int v = out[i], j = i;
+                for (; j > 0 && out[j - 1] > v; j--) out[j] = out[j - 1];
+                out[j] = v;
+            }
+        } else {
+            std::sort(out, out + count);
+        }
+        return count;
+    }
+
+    /*
+     f(n, divs, count) for every n in [lo, hi], from `threads` threads.
+     Blocks of numbers are handed out from a shared counter, so calls
+     for different n run concurrently and in no particular order.
+    */
+    template <class F>
+    void forEachRange(int lo, int hi, int threads, F f) const {
+        lo = std::max(lo, 1);
+        hi = std::min(hi, limit());
+        if (hi < lo) return;
+
+        const int BLOCK = 4096;
+        long long blocks = ((long long)hi - lo) / BLOCK + 1;
+        threads = (int)std::max(1LL, std::min<long long>(threads, blocks));
+        std::atomic<long long> next{0};
+
+        auto work = [&] {
+            std::vector<int> buf(MAX_DIVISORS);
+            long long b;
+            while ((b = next++) < blocks) {
+                int first = lo + (int)(b * BLOCK);
+                int last = (int)std::min<long long>(hi, (long long)first + BLOCK - 1);
+                for (int n = first; n <= last; n++)
+                    f(n, buf.data(), divisors(n, buf.data()));
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (int t = 1; t < threads; t++) pool.emplace_back(work);
+        work();
+        for (auto& th : pool) th.join();
+    }
+
+private:
+    std::vector<int> spf;
+};
+
+/* ---------- Benchmark ---------- */
+
+void bench(int N) {
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "divisors of every n in [1, " << N << "]\n";
+
+    // checksum: sum over n of (count + largest proper divisor)
+    long long setSum = 0;
+    double tSet = timeIt([&] {
+        for (int n = 1; n <= N; n++) {
+            std::set<int> s = divisors(n);
+            setSum += s.size() + (s.size() > 1 ? *std::prev(s.end(), 2) : 0);
+        }
+    });
+    std::cout << "  std::set per call    : " << tSet << " s (" << setSum << ")\n";
+
+    DivisorTable* table = nullptr;
+    double tBuild = timeIt([&] { table = new DivisorTable(N); });
+    std::cout << "  spf table build      : " << tBuild << " s\n";
+
+    long long flatSum = 0;
+    double tFlat = timeIt([&] {
+        std::vector<int> buf(DivisorTable::MAX_DIVISORS);
+        for (int n = 1; n <= N; n++) {
+            int c = table->divisors(n, buf.data());
+            flatSum += c + (c > 1 ? buf[c - 2] : 0);
+        }
+    });
+    std::cout << "  table, flat buffer   : " << tFlat << " s (" << flatSum << ")\n";
+
+    int cores = std::max(1u, std::thread::hardware_concurrency());
+    std::atomic<long long> parSum{0};
+    double tPar = timeIt([&] {
+        table->forEachRange(1, N, cores, [&](int, const int* d, int c) {
+            parSum.fetch_add(c + (c > 1 ? d[c - 2] : 0),
+                             std::memory_order_relaxed);
+        });
+    });
+    std::cout << "  table, " << cores << " thread(s)    : " << tPar << " s ("
+              << parSum << ")\n";
+    delete table;
+}
+
+int main(int argc, char** argv){
+    if (argc > 1 && std::string(argv[1]) == "bench") {
+        bench(argc > 2 ? std::stoi(argv[2]) : 10000000);
+        return 0;
+    }
 
     std::set<int> v = divisors(12);
     for(auto it : v) {
@@ -21,4 +181,4 @@ int main(){
     }
     std::cout << std::endl;
     return 0;
-}
\ No newline at end of file
+}
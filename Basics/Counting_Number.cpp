@@ -1,21 +1,15 @@
 #include <bits/stdc++.h>
 
-using namespace std;
+#include "digits.h"
 
-void countDigit(int n) {\
-    //n  = 1 
-        int startFactor = 10;
-        int count = 0;        
-        //n = 10 
-        do{
-            n = n/startFactor;
+using namespace std;
 
-            count++;
-        }while(n != 0);
-        cout << count << endl;
+void countDigit(long long n) {
+        // clz + table lookup, see digits.h
+        cout << digitCount((int64_t)n) << endl;
 }
 
 int main(){
     countDigit(1);
     return 0;
-}
\ No newline at end of file
+}
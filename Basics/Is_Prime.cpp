@@ -1,23 +1,297 @@
 #include <bits/stdc++.h>
+#include "../bench.h"
+
+/*
+========================================
+ PRIME ENGINE
+----------------------------------------
+ isPrime(n)         : single query, deterministic Miller-Rabin
+                      (exact for every 64-bit n). Many queries under
+                      a bound known at compile time: isPrimeUpTo<Bound>
+                      in number_tables.h (its baked 2^16 table about
+                      doubles compile time and adds ~420 KB of binary,
+                      too much for one query)
+ PrimeSieve         : segmented sieve of Eratosthenes over [lo, hi)
+   - only odd numbers are stored, one byte each
+   - wheel: multiples of 3, 5, 7, 11, 13 are never crossed off,
+     each segment starts as a copy of a precomputed pattern
+   - segments are sized for L1 (32 KB) or L2 (256 KB)
+   - count() splits the range into chunks that worker threads
+     take from a shared counter
+
+ ./Is_Prime                 -> isPrime(7)
+ ./Is_Prime bench [limit]   -> benchmark (limit default 1e9)
+========================================
+*/
+
+/* ---------- Single queries: Miller-Rabin ---------- */
+
+uint64_t mulMod(uint64_t a, uint64_t b, uint64_t m) {
+    return (unsigned __int128)a * b % m;
+}
+
+uint64_t powMod(uint64_t a, uint64_t e, uint64_t m) {
+    uint64_t r = 1;
+    a %= m;
+    while (e) {
+        if (e & 1) r = mulMod(r, a, m);
+        a = mulMod(a, a, m);
+        e >>= 1;
+    }
+    return r;
+}
+
+bool isPrime64(uint64_t n) {
+    if (n < 2) return false;
+    for (uint64_t p : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37}) {
+        if (n % p == 0) return n == p;
+    }
+    if (n < 37 * 37) return true;
+
+    uint64_t d = n - 1;
+    int s = __builtin_ctzll(d);
+    d >>= s;
+
+    // these 7 bases decide every n < 2^64
+    for (uint64_t a : {2ull, 325ull, 9375ull, 28178ull, 450775ull,
+                       9780504ull, 1795265022ull}) {
+        a %= n;
+        if (a == 0) continue;
+        uint64_t x = powMod(a, d, n);
+        if (x == 1 || x == n - 1) continue;
+        bool composite = true;
+        for (int r = 1; r < s && composite; r++) {
+            x = mulMod(x, x, n);
+            if (x == n - 1) composite = false;
+        }
+        if (composite) return false;
+    }
+    return true;
+}
 
 bool isPrime(int n) {
+    return n > 1 && isPrime64(n);
+}
+
+/* ---------- Bulk: segmented sieve ---------- */
+
+class PrimeSieve {
+public:
+    static const size_t L1_SEGMENT = 32 * 1024;
+    static const size_t L2_SEGMENT = 256 * 1024;
+
+    explicit PrimeSieve(size_t segmentBytes = L1_SEGMENT)
+        : segBytes(segmentBytes) {
+        // pattern[k] describes the odd number 2k + 1
+        pattern.resize(WHEEL + segBytes);
+        for (size_t k = 0; k < pattern.size(); k++) {
+            uint64_t x = 2 * k + 1;
+            pattern[k] = x % 3 && x % 5 && x % 7 && x % 11 && x % 13;
+        }
+    }
+
+    // number of primes in [lo, hi)
+    uint64_t count(uint64_t lo, uint64_t hi, int threads = 1) {
+        if (hi <= lo) return 0;
+        uint64_t total = countSmall(lo, hi);
+        prepare(hi);
+
+        uint64_t base = std::max<uint64_t>(lo | 1, 15);   // first odd > 13
+        if (base >= hi) return total;
+
+        // chunks of at least 64 segments and 16 * sqrt(hi) numbers, so
+        // finding each prime's first multiple per chunk stays noise
+        uint64_t step = 2 * segBytes;
+        uint64_t span = std::max<uint64_t>(step * 64,
+                                           (16 * preparedUpTo + step - 1) / step * step);
+        uint64_t chunks = (hi - base + span - 1) / span;
+        threads = std::max(1, std::min<int>(threads, chunks));
+
+        std::atomic<uint64_t> nextChunk{0};
+        std::vector<uint64_t> counts(threads);
+        auto work = [&](int t) {
+            std::vector<uint8_t> seg(segBytes);
+            std::vector<uint64_t> next;
+            uint64_t c;
+            while ((c = nextChunk++) < chunks) {
+                uint64_t a = base + c * span;
+                uint64_t b = std::min(hi, a + span);
+                sieveRange(a, b, seg, next,
+                           [&](const uint8_t* s, size_t n, uint64_t) {
+                    uint64_t sum = 0;
+                    for (size_t i = 0; i < n; i++) sum += s[i];
+                    counts[t] += sum;
+                });
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (int t = 1; t < threads; t++) pool.emplace_back(work, t);
+        work(0);
+        for (auto& th : pool) th.join();
+
+        for (auto c : counts) total += c;
+        return total;
+    }
+
+    // f(p) for every prime in [lo, hi), in increasing order
+    template <class F>
+    void forEach(uint64_t lo, uint64_t hi, F f) {
+        for (uint64_t p : {2, 3, 5, 7, 11, 13})
+            if (p >= lo && p < hi) f(p);
+        prepare(hi);
+
+        uint64_t base = std::max<uint64_t>(lo | 1, 15);
+        if (base >= hi) return;
+        std::vector<uint8_t> seg(segBytes);
+        std::vector<uint64_t> next;
+        sieveRange(base, hi, seg, next,
+                   [&](const uint8_t* s, size_t n, uint64_t low) {
+            for (size_t i = 0; i < n; i++)
+                if (s[i]) f(low + 2 * i);
+        });
+    }
+
+private:
+    static const size_t WHEEL = 3 * 5 * 7 * 11 * 13;   // pattern period
+
+    size_t segBytes;
+    std::vector<uint8_t> pattern;
+    std::vector<uint32_t> sievingPrimes;   // odd primes > 13
+    uint64_t preparedUpTo = 0;
+
+    static uint64_t countSmall(uint64_t lo, uint64_t hi) {
+        uint64_t c = 0;
+        for (uint64_t p : {2, 3, 5, 7, 11, 13}) c += p >= lo && p < hi;
+        return c;
+    }
+
+    // sieving primes up to sqrt(hi), plain sieve
+    void prepare(uint64_t hi) {
+        uint64_t limit = (uint64_t)std::sqrt((double)hi) + 1;
+        while (limit * limit < hi) limit++;
+        if (limit <= preparedUpTo) return;
+
+        std::vector<bool> composite(limit + 1);
+        sievingPrimes.clear();
+        for (uint64_t i = 3; i <= limit; i += 2) {
+            if (composite[i]) continue;
+            if (i > 13) sievingPrimes.push_back(i);
+            for (uint64_t j = i * i; j <= limit; j += 2 * i) composite[j] = true;
+        }
+        preparedUpTo = limit;
+    }
+
+    /*
+     Sieve odd numbers in [a, b) (a odd), one segment at a time.
+     onSegment(bytes, n, low): bytes[i] != 0 <=> low + 2i is prime.
+    */
+    template <class F>
+    void sieveRange(uint64_t a, uint64_t b, std::vector<uint8_t>& seg,
+                    std::vector<uint64_t>& next, F onSegment) {
+        // index (from a) of the first odd multiple of p at or after
+        // max(p*p, a); only primes that can reach [a, b) are needed
+        next.resize(sievingPrimes.size());
+        for (size_t j = 0; j < sievingPrimes.size(); j++) {
+            uint64_t p = sievingPrimes[j];
+            if (p * p > b) break;
+            uint64_t start = std::max(p * p, (a + p - 1) / p * p);
+            if (start % 2 == 0) start += p;
+            next[j] = (start - a) / 2;
+        }
+
+        for (uint64_t low = a; low < b; low += 2 * segBytes) {
+            size_t n = std::min<uint64_t>(segBytes, (b - low + 1) / 2);
+            uint64_t high = low + 2 * n;
+            uint64_t off = (low - a) / 2;
+
+            memcpy(seg.data(), pattern.data() + ((low - 1) / 2) % WHEEL, n);
+
+            // primes are sorted: stop at the first one whose square is
+            // past this segment, the rest keep their start untouched
+            for (size_t j = 0; j < sievingPrimes.size(); j++) {
+                uint64_t p = sievingPrimes[j];
+                if (p * p >= high) break;
+                uint64_t i = next[j] - off;
+                for (; i < n; i += p) seg[i] = 0;
+                next[j] = i + off;
+            }
+
+            onSegment(seg.data(), n, low);
+        }
+    }
+};
+
+/* ---------- Benchmark ---------- */
+
+// The original trial division loop, starting at 1 so it does not
+// divide by zero and without the printing. It only collects divisors
+// up to sqrt(n), so composites like 4, 6 or 10 also come out "prime".
+bool isPrimeTrialDivision(int n) {
     std::vector<int> v;
-    for(int i = 0; i*i <=n; i++){
-        if(n%i == 0){
+    for (int i = 1; i * i <= n; i++) {
+        if (n % i == 0) {
             v.push_back(i);
-            // int temp = (int)n/i;
-            // v.push_back(temp);
         }
     }
-    for(auto it : v){
-        std::cout << it  << " ";
-    }
-    
     return (v.size() == 2 ? true : false);
-        
 }
 
-int main(){
+void bench(uint64_t limit) {
+    std::cout << std::fixed << std::setprecision(3);
+
+    const int N = 2000000;
+    long long a = 0, b = 0;
+    double tOld = timeIt([&] {
+        for (int i = 0; i < N; i++) a += isPrimeTrialDivision(i);
+    });
+    double tMr = timeIt([&] {
+        for (int i = 0; i < N; i++) b += isPrime(i);
+    });
+    std::cout << "single queries n < " << N << "\n";
+    std::cout << "  old trial division : " << tOld << " s (" << a << ")\n";
+    std::cout << "  Miller-Rabin       : " << tMr << " s (" << b << ")\n";
+
+    uint64_t big = 0;
+    double tBig = timeIt([&] {
+        for (uint64_t n = (1ull << 62); n < (1ull << 62) + 100000; n++)
+            big += isPrime64(n);
+    });
+    std::cout << "  Miller-Rabin, 1e5 queries near 2^62: " << tBig << " s ("
+              << big << ")\n";
+
+    int cores = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "segmented sieve, primes below " << limit << "\n";
+    for (size_t segBytes : {PrimeSieve::L1_SEGMENT, PrimeSieve::L2_SEGMENT}) {
+        PrimeSieve sieve(segBytes);
+        for (int t : {1, cores}) {
+            uint64_t c = 0;
+            double s = timeIt([&] { c = sieve.count(0, limit, t); });
+            std::cout << "  " << segBytes / 1024 << " KB segments, " << t
+                      << " thread(s): " << s << " s (" << c << ")\n";
+            if (t == cores) break;
+        }
+    }
+
+    // old method over a range, for the same count on a small limit
+    uint64_t small = std::min<uint64_t>(limit, 1000000);
+    long long oldCount = 0;
+    double tRange = timeIt([&] {
+        for (uint64_t i = 0; i < small; i++) oldCount += isPrimeTrialDivision(i);
+    });
+    PrimeSieve sieve;
+    uint64_t sieveCount = 0;
+    double tSieve = timeIt([&] { sieveCount = sieve.count(0, small); });
+    std::cout << "primes below " << small << ": old " << tRange << " s ("
+              << oldCount << "), sieve " << tSieve << " s (" << sieveCount
+              << ")\n";
+}
+
+int main(int argc, char** argv){
+    if (argc > 1 && std::string(argv[1]) == "bench") {
+        bench(argc > 2 ? std::stoull(argv[2]) : 1000000000ull);
+        return 0;
+    }
     std::cout << isPrime(7) << std::endl;
     return 0;
-}
\ No newline at end of file
+}
@@ -1,19 +1,20 @@
 #include <bits/stdc++.h>
 
+#include "digits.h"
+
 using namespace std;
 
+// 0 when the reversed number does not fit in an int
  int reverseNumber(int n) {
-  // 532
-    long long num = 0;
-    while(n != 0){
-      int remainder = n/10;
-      num = num *10 + remainder;
-      n /= 10;
-    }
-    return num;
+  // 532 -> 235
+    uint64_t magnitude = n < 0 ? 0 - (uint64_t)(int64_t)n : n;
+    uint64_t num;
+    reverseDigits(magnitude, num);
+    if (num > (uint64_t)INT_MAX + (n < 0)) return 0;
+    return (int)(n < 0 ? -(int64_t)num : (int64_t)num);
 }
 
 int main(){
     cout << reverseNumber(21523) << endl;
     return 0;
-}
\ No newline at end of file
+}
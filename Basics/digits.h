@@ -0,0 +1,128 @@
+#pragma once
+#include <bits/stdc++.h>
+
+/*
+========================================
+ DIGIT KERNELS (64-bit)
+----------------------------------------
+ digitCount(x)      : log10 via clz: bits * 1233 / 4096 (1233/4096 ~
+                      log10(2)) guesses the count, one table compare
+                      fixes it. No loop, no division.
+ reverseDigits(x)   : two digits per division step, the pair reversed
+                      by a 100 entry table; 20 digit inputs are checked
+                      for overflow
+ isPalindromeNumber : below 10^19 the full reversal fits, so compare
+                      it; 20 digit values reverse only the low half
+                      against the high half, so nothing can overflow.
+                      Negatives are never palindromes ("-121" reads
+                      "121-")
+
+ Batch versions take arrays in straight loops with no early exits.
+ digitCountBatch vectorizes where the CPU has a vector clz
+ (-O3 -march=native on AVX-512CD: vplzcntq + a table gather); the
+ reverse and palindrome loops run a data-dependent number of
+ divisions, so those stay scalar.
+========================================
+*/
+
+namespace digits {
+
+struct Pow10 {
+    uint64_t v[20] = {};
+    constexpr Pow10() {
+        uint64_t p = 1;
+        for (int i = 0; i < 20; i++, p *= 10) v[i] = p;
+    }
+};
+inline constexpr Pow10 POW10;
+
+// REV2[r] = r's two digits swapped ("07" -> 70)
+struct Rev2 {
+    uint8_t v[100] = {};
+    constexpr Rev2() {
+        for (int r = 0; r < 100; r++) v[r] = (r % 10) * 10 + r / 10;
+    }
+};
+inline constexpr Rev2 REV2;
+
+}  // namespace digits
+
+// digits of x; 0 has one
+inline int digitCount(uint64_t x) {
+    x |= 1;   // same count, and clz(0) is undefined
+    int t = ((64 - __builtin_clzll(x)) * 1233) >> 12;
+    return t + (x >= digits::POW10.v[t]);
+}
+
+inline int digitCount(int64_t n) {
+    return digitCount(n < 0 ? 0 - (uint64_t)n : (uint64_t)n);
+}
+
+/*
+ x with its decimal digits reversed (1200 -> 21).
+ false if the result does not fit in 64 bits (only possible for
+ 20 digit inputs).
+*/
+inline bool reverseDigits(uint64_t x, uint64_t& out) {
+    if (x >= digits::POW10.v[19]) {
+        unsigned __int128 r = 0;
+        for (; x; x /= 10) r = r * 10 + x % 10;
+        out = (uint64_t)r;
+        return r <= UINT64_MAX;
+    }
+    uint64_t r = 0;
+    while (x >= 100) {
+        uint64_t q = x / 100;
+        r = r * 100 + digits::REV2.v[x - q * 100];
+        x = q;
+    }
+    out = x >= 10 ? r * 100 + digits::REV2.v[x] : r * 10 + x;
+    return true;
+}
+
+inline bool isPalindromeNumber(uint64_t x) {
+    if (x < digits::POW10.v[19]) {   // the reversal fits: two digits a step
+        uint64_t r;
+        reverseDigits(x, r);
+        return r == x;
+    }
+    if (x % 10 == 0) return false;   // reversed would start with 0
+    uint64_t low = 0;
+    while (x > low) {
+        low = low * 10 + x % 10;
+        x /= 10;
+    }
+    return x == low || x == low / 10;   // even / odd digit count
+}
+
+inline bool isPalindromeNumber(int64_t n) {
+    return n >= 0 && isPalindromeNumber((uint64_t)n);
+}
+
+/* ---------- Batch ---------- */
+
+inline void digitCountBatch(const uint64_t* in, uint8_t* out, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = (uint8_t)digitCount(in[i]);
+}
+
+// out[i] = reversal of in[i]; returns how many overflowed (left as 0)
+inline size_t reverseDigitsBatch(const uint64_t* in, uint64_t* out, size_t n) {
+    size_t overflow = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (!reverseDigits(in[i], out[i])) {
+            out[i] = 0;
+            overflow++;
+        }
+    }
+    return overflow;
+}
+
+// out[i] = 1 if in[i] is a palindrome; returns how many were
+inline size_t isPalindromeBatch(const uint64_t* in, uint8_t* out, size_t n) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++) {
+        out[i] = isPalindromeNumber(in[i]);
+        count += out[i];
+    }
+    return count;
+}
@@ -0,0 +1,111 @@
+#include <bits/stdc++.h>
+#include "../bench.h"
+
+#include "digits.h"
+
+using namespace std;
+
+/*
+ Benchmark: digits.h kernels vs the loops they replaced
+ (build with -O3 -march=native to let digitCountBatch vectorize)
+
+ ./digits_bench [count]   (default 10000000 values)
+*/
+
+// The old loops, minus the printing. reverseNumber's loop is shown
+// with the remainder fixed (it divided twice), isPalindrome's with
+// its int accumulator, so only values below 2^31 go through them.
+int oldCountDigit(int n) {
+    int count = 0;
+    do {
+        n = n / 10;
+        count++;
+    } while (n != 0);
+    return count;
+}
+
+long long oldReverse(int n) {
+    long long num = 0;
+    while (n != 0) {
+        num = num * 10 + n % 10;
+        n /= 10;
+    }
+    return num;
+}
+
+bool oldIsPalindrome(int n) {
+    int num = 0;
+    int check_num = n;
+    while (n != 0) {
+        num = num * 10 + n % 10;
+        n = n / 10;
+    }
+    return check_num == num;
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? stoul(argv[1]) : 10000000;
+    mt19937_64 rng(11);
+
+    // values below 2^31 with every digit count equally likely, so the
+    // old int loops can run on them too; plus full 64-bit values
+    vector<int> small(n);
+    vector<uint64_t> small64(n), wide(n);
+    for (size_t i = 0; i < n; i++) {
+        small[i] = (int)(rng() % digits::POW10.v[1 + rng() % 9]);
+        small64[i] = small[i];
+        wide[i] = rng() % digits::POW10.v[1 + rng() % 19];
+        if (i % 16 == 0) wide[i] = rng();
+    }
+
+    vector<uint8_t> out8(n);
+    vector<uint64_t> out64(n);
+    uint64_t sink = 0;
+    cout << fixed << setprecision(2);
+    cout << "ns per value, " << n << " values\n";
+
+    cout << "digit count (< 2^31)\n";
+    cout << "  old divide loop : " << nsPer(n, [&] {
+        for (int x : small) sink += oldCountDigit(x);
+    }) << "\n";
+    cout << "  clz + table     : " << nsPer(n, [&] {
+        for (uint64_t x : small64) sink += digitCount(x);
+    }) << "\n";
+    cout << "  batch           : " << nsPer(n, [&] {
+        digitCountBatch(small64.data(), out8.data(), n);
+    }) << "\n";
+
+    cout << "reverse (< 2^31)\n";
+    cout << "  old loop        : " << nsPer(n, [&] {
+        for (int x : small) sink += oldReverse(x);
+    }) << "\n";
+    cout << "  two-digit steps : " << nsPer(n, [&] {
+        reverseDigitsBatch(small64.data(), out64.data(), n);
+    }) << "\n";
+
+    cout << "palindrome (< 2^31)\n";
+    cout << "  old loop        : " << nsPer(n, [&] {
+        for (int x : small) sink += oldIsPalindrome(x);
+    }) << "\n";
+    cout << "  two-digit steps : " << nsPer(n, [&] {
+        sink += isPalindromeBatch(small64.data(), out8.data(), n);
+    }) << "\n";
+
+    cout << "full 64-bit range\n";
+    cout << "  digit count clz : " << nsPer(n, [&] {
+        for (uint64_t x : wide) sink += digitCount(x);
+    }) << "\n";
+    cout << "  digit count batch: " << nsPer(n, [&] {
+        digitCountBatch(wide.data(), out8.data(), n);
+    }) << "\n";
+    size_t overflow = 0;
+    cout << "  reverse         : " << nsPer(n, [&] {
+        overflow = reverseDigitsBatch(wide.data(), out64.data(), n);
+    }) << " (" << overflow << " overflowed)\n";
+    cout << "  palindrome      : " << nsPer(n, [&] {
+        sink += isPalindromeBatch(wide.data(), out8.data(), n);
+    }) << "\n";
+
+    keep(sink + out8[n / 2] + out64[n / 3]);
+    return 0;
+}
@@ -1,23 +1,189 @@
 // Online C++ compiler to run C++ program online
-#include <iostream>
-
- int GCD(int n1,int n2) {
-        int temp = n1;
-      
-        n1 = n2 % n1;
-        if(n1 == 1 || n1 == 0){
-            // std::cout << temp;
-            if(n1 == 1){
-                return 1;
-            }
-            return temp;
+#include <bits/stdc++.h>
+#include "../bench.h"
+
+/*
+========================================
+ GCD / LCM
+----------------------------------------
+ binaryGcd(a, b)    : Stein's algorithm, iterative; strips factors of
+                      two with ctz instead of dividing
+ GCD(n1, n2)        : any ints: signs ignored, GCD(0, n) = |n|
+ lcm(a, b, out)     : a / gcd * b in 128 bits, false if it does not
+                      fit in 64
+ extendedGcd(a, b)  : g = a*x + b*y
+ gcdOf(v, n)        : gcd of an array, stops as soon as it hits 1
+ gcdOfParallel      : same over threads, chunk by chunk; any thread
+                      reaching 1 stops the rest
+
+ ./gcd                 -> GCD(12, 51)
+ ./gcd bench [count]   -> old recursion vs binaryGcd
+========================================
+*/
+
+uint64_t binaryGcd(uint64_t a, uint64_t b) {
+    if (a == 0) return b;
+    if (b == 0) return a;
+    int az = __builtin_ctzll(a), bz = __builtin_ctzll(b);
+    int shift = std::min(az, bz);   // common factors of two
+    a >>= az;
+    // a odd; each round: b odd, replace (a, b) by (min, |b - a|).
+    // ctz(b - a) == ctz(a - b), so it runs alongside min and abs and
+    // the loop has no branch besides its exit
+    while (true) {
+        b >>= bz;
+        uint64_t diff = b - a;
+        if (diff == 0) break;
+        bz = __builtin_ctzll(diff);
+        uint64_t lo = std::min(a, b);
+        b = b > a ? diff : a - b;
+        a = lo;
+    }
+    return a << shift;
+}
+
+uint64_t magnitude(int64_t n) {
+    return n < 0 ? 0 - (uint64_t)n : (uint64_t)n;
+}
+
+long long GCD(int n1, int n2) {
+    return (long long)binaryGcd(magnitude(n1), magnitude(n2));
+}
+
+bool lcm(uint64_t a, uint64_t b, uint64_t& out) {
+    if (a == 0 || b == 0) {
+        out = 0;
+        return true;
+    }
+    unsigned __int128 l = (unsigned __int128)(a / binaryGcd(a, b)) * b;
+    out = (uint64_t)l;
+    return l <= UINT64_MAX;
+}
+
+// g = gcd(a, b) = a*x + b*y
+int64_t extendedGcd(int64_t a, int64_t b, int64_t& x, int64_t& y) {
+    int64_t x0 = 1, y0 = 0, x1 = 0, y1 = 1;
+    while (b != 0) {
+        int64_t q = a / b;
+        std::tie(a, b) = std::make_tuple(b, a - q * b);
+        std::tie(x0, x1) = std::make_tuple(x1, x0 - q * x1);
+        std::tie(y0, y1) = std::make_tuple(y1, y0 - q * y1);
+    }
+    if (a < 0) a = -a, x0 = -x0, y0 = -y0;
+    x = x0;
+    y = y0;
+    return a;
+}
+
+uint64_t gcdOf(const uint64_t* v, size_t n) {
+    uint64_t g = 0;
+    for (size_t i = 0; i < n && g != 1; i++) g = binaryGcd(g, v[i]);
+    return g;
+}
+
+uint64_t gcdOfParallel(const uint64_t* v, size_t n, int threads) {
+    const size_t CHUNK = 1 << 16;
+    size_t chunks = (n + CHUNK - 1) / CHUNK;
+    threads = (int)std::max<size_t>(1, std::min<size_t>(threads, chunks));
+
+    std::atomic<size_t> next{0};
+    std::atomic<bool> one{false};
+    std::vector<uint64_t> partial(threads, 0);
+    auto work = [&](int t) {
+        uint64_t g = 0;
+        size_t c;
+        while (!one.load(std::memory_order_relaxed) && (c = next++) < chunks) {
+            size_t b = c * CHUNK, e = std::min(n, b + CHUNK);
+            for (size_t i = b; i < e && g != 1; i++) g = binaryGcd(g, v[i]);
+            if (g == 1) one.store(true, std::memory_order_relaxed);
         }
-        n2 = temp;
-        return GCD(n1, n2);
-        // std::cout <<  "It reaches here" << std::endl;
+        partial[t] = g;
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++) pool.emplace_back(work, t);
+    work(0);
+    for (auto& th : pool) th.join();
+
+    if (one) return 1;
+    return gcdOf(partial.data(), partial.size());
+}
+
+// num[i] / den[i] in lowest terms, sign on the numerator
+void reduceFractions(int64_t* num, int64_t* den, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        int64_t g = (int64_t)binaryGcd(magnitude(num[i]), magnitude(den[i]));
+        if (g > 1) num[i] /= g, den[i] /= g;
+        if (den[i] < 0) num[i] = -num[i], den[i] = -den[i];
+    }
 }
 
-int main() {
+/* ---------- Benchmark ---------- */
+
+// The original recursion (positive inputs only: GCD(0, n) divides by 0)
+int recursiveGCD(int n1, int n2) {
+    int temp = n1;
+    n1 = n2 % n1;
+    if (n1 == 1 || n1 == 0) {
+        if (n1 == 1) {
+            return 1;
+        }
+        return temp;
+    }
+    n2 = temp;
+    return recursiveGCD(n1, n2);
+}
+
+void bench(size_t count) {
+    std::mt19937_64 rng(13);
+    std::vector<int> a(count), b(count);
+    for (size_t i = 0; i < count; i++) {
+        a[i] = rng() % INT_MAX + 1;
+        b[i] = rng() % INT_MAX + 1;
+    }
+    uint64_t sink = 0;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "pairs of 31-bit ints, ns per gcd\n";
+    std::cout << "  old recursion : " << nsPer(count, [&] {
+        for (size_t i = 0; i < count; i++) sink += recursiveGCD(a[i], b[i]);
+    }) << "\n";
+    std::cout << "  std::gcd      : " << nsPer(count, [&] {
+        for (size_t i = 0; i < count; i++) sink += std::gcd(a[i], b[i]);
+    }) << "\n";
+    std::cout << "  binaryGcd     : " << nsPer(count, [&] {
+        for (size_t i = 0; i < count; i++) sink += binaryGcd(a[i], b[i]);
+    }) << "\n";
+
+    std::vector<uint64_t> x(count), y(count);
+    for (size_t i = 0; i < count; i++) x[i] = rng() >> 1, y[i] = rng() >> 1;
+    std::cout << "pairs of 63-bit ints\n";
+    std::cout << "  std::gcd      : " << nsPer(count, [&] {
+        for (size_t i = 0; i < count; i++) sink += std::gcd(x[i], y[i]);
+    }) << "\n";
+    std::cout << "  binaryGcd     : " << nsPer(count, [&] {
+        for (size_t i = 0; i < count; i++) sink += binaryGcd(x[i], y[i]);
+    }) << "\n";
+
+    // an array whose gcd stays 6 * 7 all the way: no early exit
+    for (auto& v : x) v = (rng() % (1ull << 40) + 1) * 42;
+    int cores = std::max(1u, std::thread::hardware_concurrency());
+    uint64_t g1 = 0, gN = 0;
+    std::cout << "gcd of " << count << " values (result 42)\n";
+    std::cout << "  gcdOf         : " << nsPer(count, [&] {
+        g1 = gcdOf(x.data(), count);
+    }) << " (" << g1 << ")\n";
+    std::cout << "  " << cores << " thread(s)   : " << nsPer(count, [&] {
+        gN = gcdOfParallel(x.data(), count, cores);
+    }) << " (" << gN << ")\n";
+
+    keep(sink);
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && std::string(argv[1]) == "bench") {
+        bench(argc > 2 ? std::stoul(argv[2]) : 10000000);
+        return 0;
+    }
     std::cout << GCD(12, 51) << std::endl;
     return 0;
-}
\ No newline at end of file
+}
@@ -1,20 +1,16 @@
 #include <bits/stdc++.h>
+
+#include "digits.h"
+
 using namespace std;
 
+// widened to 64 bits, where every int reverses in full without
+// overflow; negatives are not palindromes
  bool isPalindrome(int n) {
-        int num = 0;
-        int check_num = n;
-        while(n != 0){
-            int remainder = n%10;
-            num = num * 10 + remainder;
-            n = n /10;
-        }
-    
-      bool answer = check_num == num ? true : false;
-      return answer;
+      return isPalindromeNumber((int64_t)n);
 }
 
 int main(){
     cout << isPalindrome(-121) << endl;
     return 0;
-} 
\ No newline at end of file
+}
@@ -0,0 +1,178 @@
+#pragma once
+#include <bits/stdc++.h>
+
+/*
+========================================
+ NUMBER-THEORY TABLES (compile time)
+----------------------------------------
+ Up to NUMBER_TABLES_LIMIT (default 2^16), NUMBER_TABLES holds
+   spf[n]            smallest prime factor (spf[1] = 1, spf[0] = 0)
+   divisorCounts[n]  d(n)
+   primes[]          every prime <= the limit, ascending
+ all generated by a constexpr constructor, so they sit in .rodata
+ and nothing runs at startup. Powers of ten are digits::POW10
+ (digits.h), built the same way.
+
+ The generator is one linear sieve: each composite is crossed out
+ once, by its smallest prime, then d(n) = d(m) * (k + 1) for
+ n = p^k * m. RuntimeNumberTables runs the same code into vectors.
+
+ numberTablesFor<Bound>()  : the baked tables when Bound fits under
+                             the limit, else a RuntimeNumberTables
+                             built once on first use
+ isPrimeUpTo<Bound>(n), divisorCountUpTo<Bound>(n),
+ smallestPrimeFactorUpTo<Bound>(n)   : n <= Bound
+
+ GCC evaluates at most 2^18 iterations of one loop and 2^25
+ operations per constant expression by default; limits past 2^17
+ need -fconstexpr-loop-limit= and -fconstexpr-ops-limit= raised.
+========================================
+*/
+
+#ifndef NUMBER_TABLES_LIMIT
+#define NUMBER_TABLES_LIMIT (1u << 16)
+#endif
+
+// primes <= n, by a plain sieve over a local array
+template <uint32_t N>
+constexpr size_t primePi() {
+    bool composite[N + 1] = {};
+    size_t count = 0;
+    for (uint32_t i = 2; i <= N; i++) {
+        if (composite[i]) continue;
+        count++;
+        for (uint64_t j = (uint64_t)i * i; j <= N; j += i) composite[j] = true;
+    }
+    return count;
+}
+
+/*
+ spf and d over [0, n]; primes must have room for pi(n) entries.
+ Returns the number of primes written.
+*/
+constexpr size_t fillNumberTables(uint32_t n, uint32_t* spf, uint16_t* d,
+                                  uint32_t* primes) {
+    size_t count = 0;
+    for (uint32_t i = 0; i <= n; i++) spf[i] = i < 2 ? i : 0;
+    for (uint32_t i = 2; i <= n; i++) {
+        if (spf[i] == 0) {
+            spf[i] = i;
+            primes[count++] = i;
+        }
+        for (size_t j = 0; j < count; j++) {
+            uint32_t p = primes[j];
+            if (p > spf[i] || (uint64_t)p * i > n) break;
+            spf[p * i] = p;
+        }
+    }
+
+    d[0] = 0;
+    if (n >= 1) d[1] = 1;
+    for (uint32_t i = 2; i <= n; i++) {
+        uint32_t p = spf[i], m = i / p, k = 1;
+        for (; m % p == 0; m /= p) k++;
+        d[i] = (uint16_t)(d[m] * (k + 1));
+    }
+    return count;
+}
+
+// Queries over tables built either way
+struct NumberTables {
+    uint32_t limit;
+    const uint32_t* spf;
+    const uint16_t* divisorCounts;
+    const uint32_t* primes;
+    size_t primeCount;
+
+    // all for n <= limit
+    constexpr bool isPrime(uint32_t n) const { return n >= 2 && spf[n] == n; }
+    constexpr uint32_t smallestPrimeFactor(uint32_t n) const { return spf[n]; }
+    constexpr int divisorCount(uint32_t n) const { return divisorCounts[n]; }
+
+    // pi(n)
+    size_t primesUpTo(uint32_t n) const {
+        return std::upper_bound(primes, primes + primeCount, n) - primes;
+    }
+
+    // distinct primes of n (>= 1) into p, exponents into e; returns how
+    // many (at most 9 for 32-bit n)
+    int factorize(uint32_t n, uint32_t* p, int* e) const {
+        int k = 0;
+        while (n > 1) {
+            uint32_t q = spf[n];
+            int c = 0;
+            for (; n % q == 0; n /= q) c++;
+            p[k] = q;
+            e[k++] = c;
+        }
+        return k;
+    }
+};
+
+template <uint32_t N>
+struct BakedNumberTables {
+    static constexpr size_t PRIME_COUNT = primePi<N>();
+
+    uint32_t spf[N + 1] = {};
+    uint16_t divisorCounts[N + 1] = {};
+    uint32_t primes[PRIME_COUNT] = {};
+
+    constexpr BakedNumberTables() {
+        fillNumberTables(N, spf, divisorCounts, primes);
+    }
+
+    constexpr NumberTables view() const {
+        return {N, spf, divisorCounts, primes, PRIME_COUNT};
+    }
+};
+
+inline constexpr BakedNumberTables<NUMBER_TABLES_LIMIT> NUMBER_TABLES;
+
+class RuntimeNumberTables {
+public:
+    explicit RuntimeNumberTables(uint32_t limit)
+        : n(limit), spf(limit + 1), divisorCounts(limit + 1) {
+        // pi(x) < 1.25506 x / ln x for x > 1 (Rosser & Schoenfeld)
+        primes.resize(limit < 17 ? 8 : (size_t)(1.25506 * limit / std::log(limit)) + 1);
+        primes.resize(fillNumberTables(limit, spf.data(), divisorCounts.data(),
+                                       primes.data()));
+        primes.shrink_to_fit();
+    }
+
+    NumberTables view() const {
+        return {n, spf.data(), divisorCounts.data(), primes.data(), primes.size()};
+    }
+
+private:
+    uint32_t n;
+    std::vector<uint32_t> spf;
+    std::vector<uint16_t> divisorCounts;
+    std::vector<uint32_t> primes;
+};
+
+/* ---------- Entry points for a bound known at compile time ---------- */
+
+template <uint32_t Bound>
+NumberTables numberTablesFor() {
+    if constexpr (Bound <= NUMBER_TABLES_LIMIT) {
+        return NUMBER_TABLES.view();
+    } else {
+        static const RuntimeNumberTables tables(Bound);
+        return tables.view();
+    }
+}
+
+template <uint32_t Bound>
+bool isPrimeUpTo(uint32_t n) {
+    return numberTablesFor<Bound>().isPrime(n);
+}
+
+template <uint32_t Bound>
+int divisorCountUpTo(uint32_t n) {
+    return numberTablesFor<Bound>().divisorCount(n);
+}
+
+template <uint32_t Bound>
+uint32_t smallestPrimeFactorUpTo(uint32_t n) {
+    return numberTablesFor<Bound>().smallestPrimeFactor(n);
+}
@@ -0,0 +1,98 @@
+#include <bits/stdc++.h>
+#include "../bench.h"
+
+#include "number_tables.h"
+
+using namespace std;
+
+/*
+ Benchmark: number_tables.h baked at compile time vs the same tables
+ built at run time, and both vs computing each answer per call
+
+ ./number_tables_bench [queries]   (default 10000000)
+*/
+
+bool trialIsPrime(uint32_t n) {
+    if (n < 2) return false;
+    for (uint32_t i = 2; i * i <= n; i++)
+        if (n % i == 0) return false;
+    return true;
+}
+
+int trialDivisorCount(uint32_t n) {
+    int count = 0;
+    for (uint32_t i = 1; i * i <= n; i++)
+        if (n % i == 0) count += i * i == n ? 1 : 2;
+    return count;
+}
+
+int main(int argc, char** argv) {
+    size_t q = argc > 1 ? stoul(argv[1]) : 10000000;
+    const uint32_t N = NUMBER_TABLES_LIMIT;
+    uint64_t sink = 0;
+    cout << fixed << setprecision(2);
+
+    // startup: the baked tables only cost page faults on first touch.
+    // Nothing touches them before this pass, so it is this process's
+    // first (its pages come from the page cache, or disk when evicted)
+    auto passOverBaked = [&] {
+        NumberTables t = NUMBER_TABLES.view();
+        for (uint32_t i = 0; i <= N; i++) sink += t.spf[i] + t.divisorCounts[i];
+        for (size_t i = 0; i < t.primeCount; i++) sink += t.primes[i];
+    };
+    cout << "startup, tables up to " << N << " (us)\n";
+    cout << "  baked, first touch         : " << timeIt(passOverBaked) * 1e6 << "\n";
+    cout << "  baked, warm pass           : " << nsPer(1000, [&] {
+        for (int r = 0; r < 100; r++) passOverBaked();
+    }) / 100 << "\n";
+    cout << "  built at run time          : " << nsPer(1000, [&] {
+        RuntimeNumberTables t(N);
+        sink += t.view().primeCount;
+    }) << "\n";
+    for (uint32_t big : {1u << 20, 1u << 24}) {
+        cout << "  built at run time, " << setw(8) << big << " : " << nsPer(1000, [&] {
+            RuntimeNumberTables t(big);
+            sink += t.view().primeCount;
+        }) << "\n";
+    }
+
+    mt19937 rng(5);
+    vector<uint32_t> xs(q);
+    for (auto& x : xs) x = rng() % (N + 1);
+    RuntimeNumberTables runtime(N);
+    NumberTables rt = runtime.view();
+
+    cout << "per query, n <= " << N << " (ns)\n";
+    cout << "  isPrime baked      : " << nsPer(q, [&] {
+        for (uint32_t x : xs) sink += isPrimeUpTo<N>(x);
+    }) << "\n";
+    cout << "  isPrime run time   : " << nsPer(q, [&] {
+        for (uint32_t x : xs) sink += rt.isPrime(x);
+    }) << "\n";
+    cout << "  isPrime trial      : " << nsPer(q, [&] {
+        for (uint32_t x : xs) sink += trialIsPrime(x);
+    }) << "\n";
+    cout << "  d(n) baked         : " << nsPer(q, [&] {
+        for (uint32_t x : xs) sink += divisorCountUpTo<N>(x);
+    }) << "\n";
+    cout << "  d(n) trial         : " << nsPer(q, [&] {
+        for (uint32_t x : xs) sink += trialDivisorCount(x);
+    }) << "\n";
+
+    // past the baked limit the first call pays for the build
+    const uint32_t BIG = 1u << 24;
+    for (auto& x : xs) x = rng() % (BIG + 1);
+    cout << "n <= " << BIG << " (above the limit)\n";
+    cout << "  first call (build) : " << nsPer(1, [&] {
+        sink += isPrimeUpTo<BIG>(xs[0]);
+    }) / 1000 << " us\n";
+    cout << "  isPrime per query  : " << nsPer(q, [&] {
+        for (uint32_t x : xs) sink += isPrimeUpTo<BIG>(x);
+    }) << " ns\n";
+    cout << "  isPrime trial      : " << nsPer(q, [&] {
+        for (uint32_t x : xs) sink += trialIsPrime(x);
+    }) << " ns\n";
+
+    keep(sink);
+    return 0;
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <bits/stdc++.h>
+
+/*
+========================================
+ BUFFERED OUTPUT
+----------------------------------------
+ BufferedWriter collects output in one block (64 KB by default) and
+ hands it to fwrite only when full, on flush() and on destruction:
+ one write per block instead of a flush per std::endl.
+ Integers are formatted two digits at a time from a 200 byte table,
+ right to left into a scratch buffer, then copied in.
+========================================
+*/
+
+// "00" "01" ... "99"
+struct DigitPairs {
+    char v[200] = {};
+    constexpr DigitPairs() {
+        for (int i = 0; i < 100; i++) {
+            v[2 * i] = (char)('0' + i / 10);
+            v[2 * i + 1] = (char)('0' + i % 10);
+        }
+    }
+};
+inline constexpr DigitPairs DIGIT_PAIRS;
+
+class BufferedWriter {
+public:
+    explicit BufferedWriter(FILE* out = stdout, size_t capacity = 1 << 16)
+        : out(out), buf(std::max<size_t>(capacity, 64)) {}
+    ~BufferedWriter() { flush(); }
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    void put(char c) {
+        if (used == buf.size()) flush();
+        buf[used++] = c;
+    }
+
+    void write(std::string_view s) {
+        if (s.size() > buf.size() - used) {
+            flush();
+            if (s.size() > buf.size()) {   // too big to be worth copying
+                fwrite(s.data(), 1, s.size(), out);
+                return;
+            }
+        }
+        memcpy(buf.data() + used, s.data(), s.size());
+        used += s.size();
+    }
+
+    void writeUint(uint64_t x) {
+        if (buf.size() - used < 20) flush();
+        char tmp[20];
+        char* p = tmp + 20;
+        while (x >= 100) {
+            uint64_t q = x / 100;
+            p -= 2;
+            memcpy(p, DIGIT_PAIRS.v + 2 * (x - q * 100), 2);
+            x = q;
+        }
+        if (x >= 10) {
+            p -= 2;
+            memcpy(p, DIGIT_PAIRS.v + 2 * x, 2);
+        } else {
+            *--p = (char)('0' + x);
+        }
+        size_t n = tmp + 20 - p;
+        memcpy(buf.data() + used, p, n);
+        used += n;
+    }
+
+    void writeInt(int64_t x) {
+        if (x < 0) put('-');
+        writeUint(x < 0 ? 0 - (uint64_t)x : (uint64_t)x);
+    }
+
+    BufferedWriter& operator<<(char c) { put(c); return *this; }
+    BufferedWriter& operator<<(std::string_view s) { write(s); return *this; }
+    BufferedWriter& operator<<(int x) { writeInt(x); return *this; }
+    BufferedWriter& operator<<(long x) { writeInt(x); return *this; }
+    BufferedWriter& operator<<(long long x) { writeInt(x); return *this; }
+    BufferedWriter& operator<<(unsigned x) { writeUint(x); return *this; }
+    BufferedWriter& operator<<(unsigned long x) { writeUint(x); return *this; }
+    BufferedWriter& operator<<(unsigned long long x) { writeUint(x); return *this; }
+
+    void flush() {
+        if (used) fwrite(buf.data(), 1, used, out);
+        used = 0;
+        fflush(out);
+    }
+
+private:
+    FILE* out;
+    std::vector<char> buf;
+    size_t used = 0;
+};
@@ -0,0 +1,147 @@
+#pragma once
+#include <bits/stdc++.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+========================================
+ PALINDROME ENGINE
+----------------------------------------
+ Normalization (same rule as removeNonAlnum + formatString): only
+ ASCII letters and digits count, letters compared lowercase.
+
+ isPalindrome(string_view) reads the string in place, never copies:
+   - two cursors walk in from both ends, skipping anything that is
+     not alphanumeric
+   - while 16 bytes at each end are all alphanumeric ("clean"), the
+     back block is byte-reversed and both are compared case-folded
+     in a few SSE2 instructions; a dirty block drops to the byte
+     loop for one block's worth of steps
+
+ checkFile(path, f) mmaps a file and calls f(line, isPalindrome)
+ for every line (\n or \r\n).
+========================================
+*/
+
+// lowercase letter / digit, or 0 for everything else
+struct AlnumFold {
+    unsigned char t[256] = {};
+    constexpr AlnumFold() {
+        for (int c = '0'; c <= '9'; c++) t[c] = c;
+        for (int c = 'a'; c <= 'z'; c++) t[c] = c;
+        for (int c = 'A'; c <= 'Z'; c++) t[c] = c + 32;
+    }
+};
+
+inline constexpr AlnumFold ALNUM_FOLD;
+
+inline unsigned char foldAlnum(unsigned char c) { return ALNUM_FOLD.t[c]; }
+
+// The normalized form (what formatString produced), appended to out
+inline void normalizeInto(std::string_view s, std::string& out) {
+    for (unsigned char c : s)
+        if (unsigned char f = foldAlnum(c)) out.push_back(f);
+}
+
+#if defined(__SSE2__)
+namespace palindrome_simd {
+
+// all 16 bytes in '0'..'9', 'a'..'z' or 'A'..'Z'
+inline bool clean(__m128i v) {
+    auto inRange = [](__m128i x, char lo, char hi) {
+        __m128i l = _mm_set1_epi8(lo), h = _mm_set1_epi8(hi);
+        return _mm_and_si128(_mm_cmpeq_epi8(_mm_max_epu8(x, l), x),
+                             _mm_cmpeq_epi8(_mm_min_epu8(x, h), x));
+    };
+    __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+    __m128i ok = _mm_or_si128(inRange(v, '0', '9'), inRange(lower, 'a', 'z'));
+    return _mm_movemask_epi8(ok) == 0xffff;
+}
+
+// byte 15 first (SSE2 only: no pshufb)
+inline __m128i reverse(__m128i v) {
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+    v = _mm_shufflelo_epi16(v, 0x1B);
+    v = _mm_shufflehi_epi16(v, 0x1B);
+    return _mm_shuffle_epi32(v, 0x4E);
+}
+
+}  // namespace palindrome_simd
+#endif
+
+inline bool isPalindrome(std::string_view s) {
+    const unsigned char* p = (const unsigned char*)s.data();
+    ptrdiff_t i = 0, j = (ptrdiff_t)s.size() - 1;
+
+    while (i < j) {
+#if defined(__SSE2__)
+        using namespace palindrome_simd;
+        // digits and letters all have 0x20 set once lowercased, so
+        // on clean blocks folding is a single OR
+        while (j - i + 1 >= 32) {
+            __m128i front = _mm_loadu_si128((const __m128i*)(p + i));
+            __m128i back = _mm_loadu_si128((const __m128i*)(p + j - 15));
+            if (!clean(front) || !clean(back)) break;
+            __m128i fold = _mm_set1_epi8(0x20);
+            __m128i eq = _mm_cmpeq_epi8(_mm_or_si128(front, fold),
+                                        reverse(_mm_or_si128(back, fold)));
+            if (_mm_movemask_epi8(eq) != 0xffff) return false;
+            i += 16;
+            j -= 16;
+        }
+#endif
+        // byte at a time for a block's worth of matched pairs
+        for (int steps = 0; steps < 16 && i < j; steps++) {
+            unsigned char a, b;
+            while (i < j && !(a = foldAlnum(p[i]))) i++;
+            while (i < j && !(b = foldAlnum(p[j]))) j--;
+            if (i >= j) return true;
+            if (a != b) return false;
+            i++;
+            j--;
+        }
+    }
+    return true;
+}
+
+/*
+ f(line, palindrome) for every line of the file; returns the number
+ of palindromic lines, or -1 if the file cannot be read.
+*/
+template <class F>
+long long checkFile(const std::string& path, F f) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+    struct stat st;
+    fstat(fd, &st);
+    size_t size = st.st_size;
+    if (size == 0) {
+        close(fd);
+        return 0;
+    }
+    const char* data = (const char*)mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return -1;
+    madvise((void*)data, size, MADV_SEQUENTIAL);
+
+    long long count = 0;
+    const char* p = data;
+    const char* end = data + size;
+    while (p < end) {
+        const char* nl = (const char*)memchr(p, '\n', end - p);
+        const char* e = nl ? nl : end;
+        std::string_view line(p, e - p);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        bool yes = isPalindrome(line);
+        count += yes;
+        f(line, yes);
+        p = e + 1;
+    }
+    munmap((void*)data, size);
+    return count;
+}
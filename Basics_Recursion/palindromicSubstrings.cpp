@@ -0,0 +1,204 @@
+#include<bits/stdc++.h>
+#include "../bench.h"
+
+#include "palindromicSubstrings.h"
+
+/*
+ ./palindromicSubstrings [file] [-m minLength] [-w window]
+     maximal palindromes of >= minLength (default 12) in the file (or
+     stdin): "offset length [truncated]", then longest and the number
+     of distinct palindromic substrings (a lower bound once the text
+     is longer than the window: longer palindromes are not seen)
+ ./palindromicSubstrings bench [n]
+     Manacher vs naive center expansion on DNA-like text
+ ./palindromicSubstrings check
+     scanner vs one Manacher pass over the whole text, with
+     palindromes of 2 * window - 1 .. 2 * window + 1 planted on pass
+     boundaries
+*/
+
+// Naive: expand around each of the 2n - 1 centers
+template <class F>
+void centerExpansion(const std::string& s, size_t minLength, F f) {
+    ptrdiff_t n = s.size();
+    for (ptrdiff_t c = 0; c < 2 * n - 1; c++) {
+        ptrdiff_t l = c / 2, r = l + c % 2;
+        while (l >= 0 && r < n && s[l] == s[r]) l--, r++;
+        size_t len = r - l - 1;
+        if (len >= minLength && len > 0) f(l + 1, len);
+    }
+}
+
+void benchOne(const std::string& name, const std::string& s, bool naive) {
+    const size_t MIN = 12;
+    std::cout << "== " << name << ", " << s.size() << " chars\n";
+
+    // checksum of (start, length) pairs, independent of report order
+    uint64_t sumM = 0, cntM = 0;
+    double tM = timeIt([&] {
+        manacher(s.data(), s.size(), MIN, [&](size_t st, size_t len) {
+            sumM += st * 1000003 + len;
+            cntM++;
+        });
+    });
+    std::cout << "  manacher        : " << tM << " s, " << cntM << " palindromes\n";
+
+    if (naive) {
+        uint64_t sumN = 0, cntN = 0;
+        double tN = timeIt([&] {
+            centerExpansion(s, MIN, [&](size_t st, size_t len) {
+                sumN += st * 1000003 + len;
+                cntN++;
+            });
+        });
+        std::cout << "  center expansion: " << tN << " s"
+                  << (sumN == sumM && cntN == cntM ? "" : "  MISMATCH") << "\n";
+    }
+
+    // streamed in 1 MB pieces through small chunks, must match
+    uint64_t sumS = 0, cntS = 0, truncated = 0;
+    PalindromeScanner scan(MIN, [&](uint64_t st, uint64_t len, bool t) {
+        sumS += st * 1000003 + len;
+        cntS++;
+        truncated += t;
+    }, 1 << 12, 1 << 16);
+    double tS = timeIt([&] {
+        for (size_t off = 0; off < s.size(); off += 1 << 20)
+            scan.feed(std::string_view(s).substr(off, 1 << 20));
+        scan.finish();
+    });
+    std::cout << "  scanner (64K chunks, 4K window): " << tS << " s, "
+              << truncated << " truncated"
+              << (truncated || (sumS == sumM && cntS == cntM) ? "" : "  MISMATCH")
+              << "\n";
+
+    Eertree tree;
+    double tE = timeIt([&] {
+        for (char c : s) tree.add(c);
+    });
+    std::cout << "  eertree         : " << tE << " s, " << tree.distinct()
+              << " distinct, " << tree.memoryBytes() / 1024 << " KB\n";
+}
+
+void bench(size_t n) {
+    std::cout << std::fixed << std::setprecision(3);
+    std::mt19937 rng(9);
+    const char dna[] = "acgt";
+
+    std::string random(n, 'a');
+    for (auto& c : random) c = dna[rng() % 4];
+    benchOne("random DNA", random, true);
+
+    // low complexity: "at" repeats with 0.1% point mutations
+    // (center expansion goes quadratic on these)
+    for (size_t len : {n / 100, n}) {
+        std::string repeat(len, 'a');
+        for (size_t i = 0; i < len; i++)
+            repeat[i] = rng() % 1000 ? "at"[i % 2] : dna[rng() % 4];
+        benchOne("AT repeat", repeat, len < n);
+    }
+}
+
+/*
+ Every palindrome the whole-text pass finds must be reported once by
+ the scanner: exact and not truncated below 2 * window, otherwise
+ with truncated = true and at most the true length.
+*/
+bool checkScanner(size_t window, size_t chunk, size_t minLength, std::mt19937& rng) {
+    std::string s(8 * chunk, 'a');
+    for (auto& c : s) c = "abc"[rng() % 3];
+    for (size_t b = chunk, k = 0; b + 2 * window + 2 < s.size(); b += chunk, k++) {
+        size_t len = 2 * window - 1 + k % 3;       // 2w - 1, 2w, 2w + 1
+        size_t start = b - len / 2;                // centered on the boundary
+        for (size_t i = 0; i < (len + 1) / 2; i++)
+            s[start + i] = s[start + len - 1 - i] = "ab"[rng() % 2];
+        s[start - 1] = 'x';                        // stop it from growing
+        s[start + len] = 'y';
+    }
+
+    std::map<std::pair<uint64_t, uint64_t>, uint64_t> expect;   // (center, odd) -> length
+    manacher(s.data(), s.size(), minLength, [&](size_t st, size_t len) {
+        expect[{st + len / 2, len % 2}] = len;
+    });
+
+    bool ok = true;
+    size_t seen = 0;
+    PalindromeScanner scan(minLength, [&](uint64_t st, uint64_t len, bool t) {
+        auto it = expect.find({st + len / 2, len % 2});
+        if (it == expect.end()) {
+            ok = false;
+            return;
+        }
+        uint64_t full = it->second;
+        seen++;
+        if (full < 2 * window || !t) ok &= !t && len == full;
+        else ok &= len <= full;
+    }, window, chunk);
+    for (size_t off = 0; off < s.size(); off += 1000) scan.feed(std::string_view(s).substr(off, 1000));
+    scan.finish();
+    return ok && seen == expect.size();
+}
+
+void check() {
+    std::mt19937 rng(16);
+    bool ok = true;
+    for (size_t window : {4, 8, 64})
+        for (size_t minLength : {(size_t)1, window})
+            for (int round = 0; round < 20; round++)
+                ok &= checkScanner(window, 8 * window, minLength, rng);
+    std::cout << (ok ? "scanner ok\n" : "scanner MISMATCH\n");
+}
+
+int main(int argc, char** argv){
+    if (argc > 1 && std::string(argv[1]) == "bench") {
+        bench(argc > 2 ? std::stoul(argv[2]) : 10000000);
+        return 0;
+    }
+    if (argc > 1 && std::string(argv[1]) == "check") {
+        check();
+        return 0;
+    }
+
+    size_t minLength = 12, window = 1 << 16;
+    const char* path = nullptr;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        if (a == "-m" && i + 1 < argc) minLength = std::stoul(argv[++i]);
+        else if (a == "-w" && i + 1 < argc) window = std::stoul(argv[++i]);
+        else path = argv[i];
+    }
+    FILE* in = path ? fopen(path, "rb") : stdin;
+    if (!in) {
+        perror(path);
+        return 1;
+    }
+
+    std::string out;
+    PalindromeScanner scan(minLength, [&](uint64_t st, uint64_t len, bool t) {
+        out += std::to_string(st) + " " + std::to_string(len) +
+               (t ? " truncated\n" : "\n");
+        if (out.size() >= 1 << 16) {
+            fwrite(out.data(), 1, out.size(), stdout);
+            out.clear();
+        }
+    }, window);
+    Eertree tree(window);
+
+    std::vector<char> buf(1 << 20);
+    size_t n;
+    while ((n = fread(buf.data(), 1, buf.size(), in)) > 0) {
+        std::string_view piece(buf.data(), n);
+        scan.feed(piece);
+        tree.add(piece);
+    }
+    scan.finish();
+    fwrite(out.data(), 1, out.size(), stdout);
+
+    std::cout << "length " << scan.length() << ", " << scan.reported()
+              << " palindromes >= " << minLength << ", longest "
+              << scan.longest() << " at " << scan.longestAt() << ", "
+              << (scan.length() > window ? "at least " : "")
+              << tree.distinct() << " distinct palindromic substrings"
+              << std::endl;
+    return 0;
+}
@@ -0,0 +1,206 @@
+#pragma once
+#include <bits/stdc++.h>
+
+#include "palindrome.h"
+
+/*
+========================================
+ PALINDROMIC SUBSTRINGS
+----------------------------------------
+ Text is normalized with the palindrome.h rule (ASCII letters and
+ digits, lowercase, everything else dropped); offsets and lengths
+ below count normalized characters.
+
+ manacher(s, n, f)
+   every center's maximal palindrome in O(n): f(start, length).
+   Odd centers on each character, even centers between neighbours.
+
+ PalindromeScanner(minLength, window, chunk)
+   the same over a stream of any size, `chunk` centers at a time.
+   Each Manacher pass sees `window` extra characters on both sides,
+   so palindromes shorter than 2 * window come out exact; one that runs
+   into the edge of its pass (from 2 * window on, when its center
+   sits next to a pass boundary) is reported with truncated = true and
+   its length is a lower bound. Memory: chunk + 2 * window chars.
+
+ Eertree
+   palindromic tree: one node per distinct palindrome, fed a character
+   at a time. distinct() = distinct palindromic substrings,
+   occurrences() = palindromic substrings counted with repeats.
+   Keeps the last `history` characters, so palindromes longer than
+   that are not recognized.
+========================================
+*/
+
+// f(start, length) for every center with a palindrome of >= minLength
+template <class F>
+void manacher(const char* s, size_t n, size_t minLength, F f) {
+    std::vector<uint32_t> d1(n), d2(n);
+
+    // odd: s[i - d1 + 1 .. i + d1 - 1]
+    for (ptrdiff_t i = 0, l = 0, r = -1; i < (ptrdiff_t)n; i++) {
+        ptrdiff_t k = i > r ? 1 : std::min<ptrdiff_t>(d1[l + r - i], r - i + 1);
+        while (i - k >= 0 && i + k < (ptrdiff_t)n && s[i - k] == s[i + k]) k++;
+        d1[i] = k--;
+        if (i + k > r) l = i - k, r = i + k;
+    }
+    // even: s[i - d2 .. i + d2 - 1]
+    for (ptrdiff_t i = 0, l = 0, r = -1; i < (ptrdiff_t)n; i++) {
+        ptrdiff_t k = i > r ? 0 : std::min<ptrdiff_t>(d2[l + r - i + 1], r - i + 1);
+        while (i - k - 1 >= 0 && i + k < (ptrdiff_t)n && s[i - k - 1] == s[i + k]) k++;
+        d2[i] = k--;
+        if (i + k > r) l = i - k - 1, r = i + k;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        if (d2[i] && 2 * (size_t)d2[i] >= minLength) f(i - d2[i], 2 * (size_t)d2[i]);
+        if (2 * (size_t)d1[i] - 1 >= minLength) f(i - d1[i] + 1, 2 * (size_t)d1[i] - 1);
+    }
+}
+
+class PalindromeScanner {
+public:
+    // (offset, length, truncated)
+    using Callback = std::function<void(uint64_t, uint64_t, bool)>;
+
+    PalindromeScanner(size_t minLength, Callback f, size_t window = 1 << 16,
+                      size_t chunk = 1 << 22)
+        : minLength(std::max<size_t>(1, minLength)), window(window),
+          chunk(chunk), report(std::move(f)) {}
+
+    // raw text, any size, any split
+    void feed(std::string_view raw) {
+        normalizeInto(raw, buf);
+        while (base + buf.size() >= done + chunk + window) pass(done + chunk, false);
+    }
+
+    void finish() {
+        while (done < base + buf.size()) pass(base + buf.size(), true);
+    }
+
+    uint64_t length() const { return base + buf.size(); }
+    uint64_t reported() const { return count; }
+    uint64_t longest() const { return best; }
+    uint64_t longestAt() const { return bestAt; }
+
+private:
+    size_t minLength, window, chunk;
+    Callback report;
+
+    std::string buf;     // normalized text from offset base
+    uint64_t base = 0;
+    uint64_t done = 0;   // centers before this are reported
+    uint64_t count = 0, best = 0, bestAt = 0;
+
+    // report centers in [done, upto)
+    void pass(uint64_t upto, bool last) {
+        uint64_t from = done >= window ? done - window : 0;
+        uint64_t to = last ? base + buf.size() : upto + window;
+        const char* s = buf.data() + (from - base);
+        size_t n = to - from;
+
+        manacher(s, n, minLength, [&](size_t start, size_t len) {
+            // even centers belong to their right neighbour, odd to
+            // their middle character
+            uint64_t center = from + start + len / 2;
+            if (center < done || center >= upto) return;
+            bool truncated = (start == 0 && from > 0) ||
+                             (start + len == n && !last);
+            report(from + start, len, truncated);
+            count++;
+            if (len > best) best = len, bestAt = from + start;
+        });
+
+        done = upto;
+        // keep `window` characters of left context
+        uint64_t keep = done >= window ? done - window : 0;
+        if (keep > base) {
+            buf.erase(0, keep - base);
+            base = keep;
+        }
+    }
+};
+
+class Eertree {
+public:
+    explicit Eertree(size_t history = 1 << 16) {
+        size_t cap = 1;
+        while (cap < history + 2) cap *= 2;
+        ring.assign(cap, 0);
+        mask = cap - 1;
+        nodes.push_back({-1, 0, 0, NONE});   // imaginary root
+        nodes.push_back({0, 0, 0, NONE});    // empty string
+    }
+
+    // c: a normalized character
+    void add(char c) {
+        ring[pos & mask] = c;
+        uint32_t cur = suffixWith(last, c);
+        uint32_t child = edge(cur, c);
+        if (child == NONE) {
+            child = (uint32_t)nodes.size();
+            int len = nodes[cur].len + 2;
+            uint32_t link = len == 1 ? 1 : edge(suffixWith(nodes[cur].link, c), c);
+            if (link == NONE) link = 1;   // only past `history`
+            nodes.push_back({len, link, nodes[link].depth + 1, NONE});
+            edges.push_back({child, nodes[cur].firstEdge, c});
+            nodes[cur].firstEdge = (uint32_t)edges.size() - 1;
+        }
+        last = child;
+        total += nodes[last].depth;
+        pos++;
+    }
+
+    void add(std::string_view raw) {
+        for (unsigned char c : raw)
+            if (unsigned char f = foldAlnum(c)) add((char)f);
+    }
+
+    size_t distinct() const { return nodes.size() - 2; }
+    uint64_t occurrences() const { return total; }
+    size_t memoryBytes() const {
+        return nodes.capacity() * sizeof(Node) + edges.capacity() * sizeof(Edge) +
+               ring.size();
+    }
+
+private:
+    static const uint32_t NONE = UINT32_MAX;
+
+    struct Node {
+        int len;
+        uint32_t link;        // longest proper palindromic suffix
+        uint32_t depth;       // palindromic suffixes, itself included
+        uint32_t firstEdge;
+    };
+    struct Edge {
+        uint32_t to;
+        uint32_t next;        // next edge of the same node
+        char c;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<Edge> edges;
+    std::vector<char> ring;   // last characters, ring[i & mask]
+    size_t mask;
+    uint64_t pos = 0;
+    uint32_t last = 1;
+    uint64_t total = 0;
+
+    // longest palindromic suffix X of node v's chain with c X c a suffix
+    uint32_t suffixWith(uint32_t v, char c) const {
+        while (true) {
+            int len = nodes[v].len;
+            if (len == -1) return v;
+            uint64_t back = (uint64_t)len + 1;
+            if (back <= pos && back < ring.size() && ring[(pos - back) & mask] == c)
+                return v;
+            v = nodes[v].link;
+        }
+    }
+
+    uint32_t edge(uint32_t v, char c) const {
+        for (uint32_t e = nodes[v].firstEdge; e != NONE; e = edges[e].next)
+            if (edges[e].c == c) return edges[e].to;
+        return NONE;
+    }
+};
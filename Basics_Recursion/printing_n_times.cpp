@@ -1,19 +1,100 @@
 // Online C++ compiler to run C++ program online
 #include <bits/stdc++.h>
+#include "../bench.h"
 
-//forward tracking 
+#include "bufferedWriter.h"
+#include "trampoline.h"
 
-void ForwardTracking(int a , int max){
+/*
+ ./printing_n_times              -> 1..10, forward tracking
+ ./printing_n_times N            -> 1..N, any N: constant stack
+ ./printing_n_times back N       -> 1..N, printed on the way back
+                                    out of the recursion
+ ./printing_n_times bench [N]    -> print 1..N (default 1e8) to stdout,
+                                    timings on stderr; redirect stdout
+*/
+
+//forward tracking
+
+// The original: one native frame per value (unless the compiler turns
+// the tail call into a jump) and a flush per line
+void ForwardTrackingRecursive(int a , int max){
     if(a > max){
         return;
     }
     std::cout << a << std::endl;
-    ForwardTracking(a + 1, max);
+    ForwardTrackingRecursive(a + 1, max);
 }
 
-int main() {
-    // Write C++ code here
-    ForwardTracking(1, 10);
-    return 0;
-}   
+// Same recursion, driven by the trampoline
+void ForwardTracking(int a, int max, BufferedWriter& out) {
+    using Call = Bounce<int, std::pair<int, int>>;
+    trampoline<int>([&](std::pair<int, int> args) {
+        auto [a, max] = args;
+        if (a > max) {
+            return Call::done(0);
+        }
+        out << a << '\n';
+        return Call::call({a + 1, max});
+    }, std::pair<int, int>{a, max});
+}
+
+//back tracking: recurse first, print after the call returns
+
+void BackTracking(int i, BufferedWriter& out) {
+    struct Frame {
+        int i;
+        bool resumed;
+    };
+    explicitStack(Frame{i, false}, [&](Frame f, std::vector<Frame>& stack) {
+        if (f.resumed) {
+            out << f.i << '\n';
+            return;
+        }
+        if (f.i < 1) {
+            return;
+        }
+        stack.push_back({f.i, true});       // the print after the call
+        stack.push_back({f.i - 1, false});  // BackTracking(i - 1)
+    });
+}
 
+void bench(int n) {
+    // a flush per line makes the original about a syscall per value, and
+    // it holds one native frame per value (an unoptimized build does not
+    // turn the tail call into a jump), so it gets a slice the default
+    // 8 MB stack can hold
+    int slice = std::min(n, 10000);
+    std::cerr << std::fixed << std::setprecision(2) << "ns per value\n";
+    std::cerr << "  recursion + endl (" << slice << " values): " << nsPer(slice, [&] {
+        ForwardTrackingRecursive(1, slice);
+    }) << "\n";
+    std::cerr << "  loop + cout '\\n' (" << n << "): " << nsPer(n, [&] {
+        for (int a = 1; a <= n; a++) std::cout << a << '\n';
+        std::cout.flush();
+    }) << "\n";
+    std::cerr << "  trampoline + writer (" << n << "): " << nsPer(n, [&] {
+        BufferedWriter out;
+        ForwardTracking(1, n, out);
+    }) << "\n";
+    // depth n: the frame vector peaks at n resumed frames (8 bytes each)
+    std::cerr << "  explicit stack + writer (" << n << "): " << nsPer(n, [&] {
+        BufferedWriter out;
+        BackTracking(n, out);
+    }) << "\n";
+}
+
+int main(int argc, char** argv) {
+    std::string mode = argc > 1 ? argv[1] : "";
+    if (mode == "bench") {
+        bench(argc > 2 ? std::stoi(argv[2]) : 100000000);
+        return 0;
+    }
+    BufferedWriter out;
+    if (mode == "back") {
+        BackTracking(argc > 2 ? std::stoi(argv[2]) : 10, out);
+    } else {
+        ForwardTracking(1, argc > 1 ? std::stoi(argv[1]) : 10, out);
+    }
+    return 0;
+}
@@ -1,4 +1,13 @@
 #include<bits/stdc++.h>
+#include "../bench.h"
+
+#include "palindrome.h"
+
+/*
+ ./stringPalindrome                 -> "hannah"
+ ./stringPalindrome file <path>     -> one line per string: 1 / 0
+ ./stringPalindrome bench [count]   -> old copying path vs palindrome.h
+*/
 
  std::string removeNonAlnum(std::string s) {
         s.erase(
@@ -18,12 +27,14 @@ std::string formatString(std::string &s){
     if(!std::islower(s[i])) {
         s[i] = std::tolower(s[i]);
         }
-        
+
     }
     return s;
 }
 
-bool isPalindrome(std::string& s) {
+// The copying version (overwrites s with its normalized form), kept
+// for the benchmark; isPalindrome(string_view) is in palindrome.h
+bool isPalindromeFormatted(std::string& s) {
     s = formatString(s);
     int i = 0, indexes = s.length() - 1;
     while(i < indexes){
@@ -36,8 +47,95 @@ bool isPalindrome(std::string& s) {
     return true;
 }
 
-int main(){
+/* ---------- Benchmark ---------- */
+
+// Half palindromes (some punctuated / mixed case), half near misses
+std::vector<std::string> makeInputs(size_t count, size_t len, bool punctuate) {
+    std::mt19937 rng(5);
+    const char letters[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+    std::vector<std::string> out;
+    for (size_t n = 0; n < count; n++) {
+        std::string half;
+        for (size_t i = 0; i < len / 2; i++) half += letters[rng() % 36];
+        std::string s = half + std::string(half.rbegin(), half.rend());
+        if (n % 2) s[s.size() / 2 + rng() % (s.size() / 2)] ^= 1;   // miss
+        if (punctuate) {
+            std::string p;
+            for (char c : s) {
+                p += rng() % 4 ? c : (char)toupper(c);
+                if (rng() % 12 == 0) p += ", "[rng() % 2];
+            }
+            s = p;
+        }
+        out.push_back(s);
+    }
+    return out;
+}
+
+void bench(size_t count) {
+    std::cout << std::fixed << std::setprecision(1);
+    for (size_t len : {16, 256, 4096}) {
+        for (bool punctuate : {false, true}) {
+            size_t n = std::max<size_t>(1000, count * 16 / len);
+            auto inputs = makeInputs(n, len, punctuate);
+            size_t bytes = 0;
+            for (auto& s : inputs) bytes += s.size();
+
+            long long a = 0, b = 0;
+            auto copies = inputs;
+            double tOld = timeIt([&] {
+                for (auto& s : copies) a += isPalindromeFormatted(s);
+            });
+            double tNew = timeIt([&] {
+                for (auto& s : inputs) b += isPalindrome(s);
+            });
+            std::cout << std::setw(5) << len << " chars, "
+                      << (punctuate ? "punctuated" : "clean     ") << " : old "
+                      << std::setw(7) << bytes / tOld / 1e6 << " MB/s, new "
+                      << std::setw(7) << bytes / tNew / 1e6 << " MB/s"
+                      << (a == b ? "" : "  MISMATCH") << "\n";
+        }
+    }
+
+    // batch: a file of short lines
+    std::string path = "/tmp/stringPalindrome-bench.txt";
+    {
+        std::ofstream out(path);
+        for (auto& s : makeInputs(count, 24, true)) out << s << '\n';
+    }
+    long long found = 0;
+    double tFile = timeIt([&] {
+        found = checkFile(path, [](std::string_view, bool) {});
+    });
+    std::cout << "file of " << count << " lines: " << tFile << " s, "
+              << count / tFile / 1e6 << " M lines/s (" << found
+              << " palindromes)\n";
+    unlink(path.c_str());
+}
+
+int main(int argc, char** argv){
+    if (argc > 2 && std::string(argv[1]) == "file") {
+        std::string out;
+        long long n = checkFile(argv[2], [&](std::string_view, bool yes) {
+            out += yes ? "1\n" : "0\n";
+            if (out.size() >= 1 << 16) {
+                fwrite(out.data(), 1, out.size(), stdout);
+                out.clear();
+            }
+        });
+        fwrite(out.data(), 1, out.size(), stdout);
+        if (n < 0) {
+            perror(argv[2]);
+            return 1;
+        }
+        return 0;
+    }
+    if (argc > 1 && std::string(argv[1]) == "bench") {
+        bench(argc > 2 ? std::stoul(argv[2]) : 2000000);
+        return 0;
+    }
+
     std::string name = "hannah";
     std::cout << isPalindrome(name) << std::endl;
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <bits/stdc++.h>
+
+/*
+========================================
+ RECURSION WITHOUT THE NATIVE STACK
+----------------------------------------
+ trampoline(f, args)
+   tail recursion as a loop. f(args) returns either
+   Bounce::call(nextArgs) (the recursive call it would have made)
+   or Bounce::done(result). Constant native stack at any depth.
+
+ explicitStack(root, f)
+   general recursion: frames live in a vector on the heap. f(frame,
+   stack) does one frame's work and pushes the calls it would make,
+   last call first. For work after a call returns, push the frame
+   again (marked as resumed) below its children.
+========================================
+*/
+
+template <class R, class Args>
+struct Bounce {
+    std::optional<Args> next;
+    R result{};
+
+    static Bounce call(Args a) { return {std::move(a), R{}}; }
+    static Bounce done(R r) { return {std::nullopt, std::move(r)}; }
+};
+
+template <class R, class Args, class F>
+R trampoline(F f, Args args) {
+    while (true) {
+        Bounce<R, Args> b = f(args);
+        if (!b.next) return std::move(b.result);
+        args = std::move(*b.next);
+    }
+}
+
+template <class Frame, class F>
+void explicitStack(Frame root, F f) {
+    std::vector<Frame> stack{std::move(root)};
+    while (!stack.empty()) {
+        Frame frame = std::move(stack.back());
+        stack.pop_back();
+        f(frame, stack);
+    }
+}
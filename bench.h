@@ -0,0 +1,39 @@
+#pragma once
+#include <bits/stdc++.h>
+
+/*
+========================================
+ BENCHMARK HELPERS (shared by every *Bench / bench mode)
+----------------------------------------
+ timeIt(f)      seconds f() took, steady clock
+ msFor(f)       the same in milliseconds
+ nsPer(n, f)    nanoseconds per item, f() handling n items
+
+ keep(x)        stores x to a volatile: the work that produced x
+                counts as used, so the optimizer cannot drop a
+                benchmark loop whose result is otherwise ignored
+========================================
+*/
+
+template <class F>
+double timeIt(F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <class F>
+double msFor(F f) {
+    return timeIt(f) * 1e3;
+}
+
+template <class F>
+double nsPer(size_t n, F f) {
+    return timeIt(f) * 1e9 / n;
+}
+
+template <class T>
+void keep(const T& x) {
+    [[maybe_unused]] static volatile T sink;
+    sink = x;
+}
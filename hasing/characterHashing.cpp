@@ -1,19 +1,241 @@
 #include<bits/stdc++.h>
+#include "../bench.h"
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
+/*
+========================================
+ BYTE HISTOGRAM
+----------------------------------------
+ ByteHistogram counts all 256 byte values in ONE pass, fed in chunks
+ of any size (add() as data arrives, counts at any time).
+
+ - consecutive bytes usually repeat (text, logs), and ++t[b] twice on
+   the same slot has to wait for the previous store to land; so bytes
+   go round-robin into 8 separate sub-histograms and are summed at the
+   end (or every FLUSH bytes, before the 32-bit counters could wrap)
+ - input is read 8 bytes per load. There is no vector
+   scatter-increment, so SIMD only pays where it skips table updates:
+   the AVX2 path spots 32 equal bytes with one compare and adds 32 at
+   once (padding, runs of spaces), else splits them like the scalar
+   loop. Picked at run time (x86-64 only).
+
+ ./characterHashing                -> one word from stdin, counts a..z
+ ./characterHashing stream         -> all of stdin, every byte seen
+ ./characterHashing bench [MB]     -> GB/s, default 256 MB
+========================================
+*/
+
 int characterFrequencies(string s, char c );
 
-int main(){
+class ByteHistogram {
+public:
+    static const int WAYS = 8;
+    static const size_t FLUSH = 1u << 30;   // < 2^32 / WAYS per table slot
+
+    enum Path { SCALAR, AVX2 };
+
+    ByteHistogram() : path(bestPath()) { memset(sub, 0, sizeof(sub)); }
+
+    void add(const char* p, size_t n) {
+        const unsigned char* u = (const unsigned char*)p;
+        while (n > 0) {
+            size_t k = min(n, FLUSH - pending);
+            switch (path) {
+                case AVX2: countAvx2(u, k); break;
+                default: countScalar(u, k); break;
+            }
+            u += k;
+            n -= k;
+            pending += k;
+            if (pending == FLUSH) flush();
+        }
+    }
+
+    void add(string_view s) { add(s.data(), s.size()); }
+
+    uint64_t count(unsigned char b) {
+        flush();
+        return total[b];
+    }
+
+    const array<uint64_t, 256>& counts() {
+        flush();
+        return total;
+    }
+
+    void setPath(Path p) { path = p; }
+    static const char* pathName(Path p) {
+        return p == AVX2 ? "avx2" : "scalar";
+    }
+    static Path bestPath() {
+#if defined(__x86_64__)
+        if (__builtin_cpu_supports("avx2")) return AVX2;
+#endif
+        return SCALAR;
+    }
+
+private:
+    uint32_t sub[WAYS][256];
+    array<uint64_t, 256> total{};
+    size_t pending = 0;
+    Path path;
+
+    void flush() {
+        for (int b = 0; b < 256; b++) {
+            uint64_t s = 0;
+            for (int w = 0; w < WAYS; w++) s += sub[w][b];
+            total[b] += s;
+        }
+        memset(sub, 0, sizeof(sub));
+        pending = 0;
+    }
+
+    // 8 bytes of one 64-bit word, one per sub-histogram
+    inline void count8(uint64_t x) {
+        sub[0][x & 0xff]++;
+        sub[1][(x >> 8) & 0xff]++;
+        sub[2][(x >> 16) & 0xff]++;
+        sub[3][(x >> 24) & 0xff]++;
+        sub[4][(x >> 32) & 0xff]++;
+        sub[5][(x >> 40) & 0xff]++;
+        sub[6][(x >> 48) & 0xff]++;
+        sub[7][x >> 56]++;
+    }
+
+    void tail(const unsigned char* p, size_t n) {
+        for (size_t i = 0; i < n; i++) sub[i % WAYS][p[i]]++;
+    }
+
+    void countScalar(const unsigned char* p, size_t n) {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            uint64_t a, b;
+            memcpy(&a, p + i, 8);
+            memcpy(&b, p + i + 8, 8);
+            count8(a);
+            count8(b);
+        }
+        tail(p + i, n - i);
+    }
+
+#if defined(__x86_64__)
+    __attribute__((target("avx2"))) void countAvx2(const unsigned char* p,
+                                                   size_t n) {
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            __m256i v = _mm256_loadu_si256((const __m256i*)(p + i));
+            // 32 copies of one byte (padding, runs of spaces): one add
+            __m256i first = _mm256_set1_epi8((char)p[i]);
+            if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, first)) == -1) {
+                sub[0][p[i]] += 32;
+                continue;
+            }
+            count8((uint64_t)_mm256_extract_epi64(v, 0));
+            count8((uint64_t)_mm256_extract_epi64(v, 1));
+            count8((uint64_t)_mm256_extract_epi64(v, 2));
+            count8((uint64_t)_mm256_extract_epi64(v, 3));
+        }
+        tail(p + i, n - i);
+    }
+#else
+    void countAvx2(const unsigned char* p, size_t n) { countScalar(p, n); }
+#endif
+};
+
+// Feed a whole stream through in 1 MB chunks
+void histogramStream(FILE* in, ByteHistogram& h) {
+    vector<char> buf(1 << 20);
+    size_t n;
+    while ((n = fread(buf.data(), 1, buf.size(), in)) > 0) h.add(buf.data(), n);
+}
+
+/* ---------- Benchmark ---------- */
+
+void benchData(const string& name, const string& data) {
+    cout << "== " << name << ", " << (data.size() >> 20) << " MB\n";
+
+    // the old loop rescans the whole string for every character,
+    // so it only gets a small piece
+    string small = data.substr(0, 64 << 10);
+    int arr[26] = {0};
+    double tOld = timeIt([&] {
+        for (size_t i = 0; i < small.length(); i++)
+            if (small[i] >= 'a' && small[i] <= 'z')
+                arr[small[i] - 'a'] = characterFrequencies(small, small[i]);
+    });
+    cout << "  old (64 KB)  : " << small.size() / tOld / 1e6 << " MB/s\n";
+
+    for (auto p : {ByteHistogram::SCALAR, ByteHistogram::AVX2}) {
+        if (p > ByteHistogram::bestPath()) break;
+        ByteHistogram h;
+        h.setPath(p);
+        double t = timeIt([&] {
+            // fed in 1 MB chunks, like the stream
+            for (size_t off = 0; off < data.size(); off += 1 << 20)
+                h.add(data.data() + off, min<size_t>(1 << 20, data.size() - off));
+            h.counts();
+        });
+        cout << "  " << setw(12) << left << ByteHistogram::pathName(p) << right
+             << " : " << data.size() / t / 1e9 << " GB/s  (' ' = "
+             << h.count(' ') << ")\n";
+    }
+
+    // one table, one increment per byte, for reference
+    uint64_t naive[256] = {0};
+    double tNaive = timeIt([&] {
+        for (unsigned char c : data) naive[c]++;
+    });
+    cout << "  single table : " << data.size() / tNaive / 1e9
+         << " GB/s  (' ' = " << naive[' '] << ")\n";
+}
+
+void bench(size_t mb) {
+    cout << fixed << setprecision(2);
+    mt19937 rng(1);
+
+    // random text: lowercase, spaces, digits and newlines
+    string text(mb << 20, ' ');
+    const char alphabet[] = "abcdefghijklmnopqrstuvwxyz     0123456789\n";
+    for (auto& c : text) c = alphabet[rng() % (sizeof(alphabet) - 1)];
+    benchData("random text", text);
+
+    // fixed-width log records: ~40 bytes of text padded to 256
+    string padded(mb << 20, ' ');
+    for (size_t off = 0; off < padded.size(); off += 256) {
+        for (size_t i = 0; i < 40; i++)
+            padded[off + i] = alphabet[rng() % (sizeof(alphabet) - 1)];
+        padded[off + 255] = '\n';
+    }
+    benchData("padded records", padded);
+}
+
+int main(int argc, char** argv){
+    if (argc > 1 && string(argv[1]) == "bench") {
+        bench(argc > 2 ? stoul(argv[2]) : 256);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "stream") {
+        ByteHistogram h;
+        histogramStream(stdin, h);
+        for (int b = 0; b < 256; b++) {
+            if (!h.count(b)) continue;
+            if (isgraph(b)) cout << (char)b;
+            else cout << "0x" << hex << b << dec;
+            cout << " " << h.count(b) << endl;
+        }
+        return 0;
+    }
+
     string s;
     cin >> s;
-    int sizeOfLetters = 26;
-    int arr[sizeOfLetters] = {0};
-    for(int i = 0; i < s.length(); i++){
-        arr[s[i] - 'a'] = characterFrequencies(s ,s[i]);
-    }
-    for(auto it:arr){
-        cout << it << endl;
+    ByteHistogram h;
+    h.add(s);
+    for(char c = 'a'; c <= 'z'; c++){
+        cout << h.count(c) << endl;
     }
 }
 
@@ -25,4 +247,4 @@ int characterFrequencies(string s, char c ){
         }
     }
     return count;
-}
\ No newline at end of file
+}
@@ -0,0 +1,141 @@
+#include <bits/stdc++.h>
+#include "../bench.h"
+
+#include "frequencyCounter.h"
+
+using namespace std;
+
+/*
+========================================
+ FREQUENCY COUNTING BENCHMARK
+----------------------------------------
+ n keys, `distinct` different values, counted in first-occurrence
+ order (q1's output). Times in ms.
+
+   old      : q1's countFrequencies (std::set + rescan per new key),
+              only run while n * distinct stays small
+   map      : std::map, then the first-occurrence order rebuilt
+   umap     : std::unordered_map, same
+   hash / radix / auto : frequenciesOf() strategies
+   dense    : keys are 0..distinct-1 (the others get scattered keys)
+
+ then frequenciesParallel() on max n keys, 1 to 64 threads, at low
+ (1000) and high (n) cardinality, speedup vs the 1 thread HASH path
+
+ usage: ./frequencyBench [max n]   (default 10000000)
+========================================
+*/
+
+// q1.cpp's countFrequencies before FrequencyCounter, as the baseline
+vector<vector<int>> oldCountFrequencies(vector<int>& nums) {
+    vector<vector<int>> v;
+    set<int> alreadythere;
+    for (auto it : nums) {
+        if (alreadythere.find(it) != alreadythere.end()) continue;
+        alreadythere.insert(it);
+        int numCount = 0;
+        for (auto x : nums) numCount += x == it;
+        v.push_back({it, numCount});
+    }
+    return v;
+}
+
+template <class Map>
+Frequencies withStdMap(const vector<int>& nums) {
+    Map counts;
+    vector<int> order;
+    for (int x : nums)
+        if (counts[x]++ == 0) order.push_back(x);
+    Frequencies out;
+    out.reserve(order.size());
+    for (int x : order) out.push_back({x, counts[x]});
+    return out;
+}
+
+int main(int argc, char** argv) {
+    size_t maxN = argc > 1 ? stoul(argv[1]) : 10000000;
+    mt19937 rng(7);
+
+    cout << fixed << setprecision(1);
+    cout << setw(10) << "n" << setw(10) << "distinct";
+    for (auto name : {"old", "map", "umap", "hash", "radix", "auto", "dense"})
+        cout << setw(10) << name;
+    cout << "\n";
+
+    for (size_t n = 10000; n <= maxN; n *= 10) {
+        set<size_t> cards = {16, 1000, n / 10, n};
+        for (size_t distinct : cards) {
+            // dense keys 0..distinct-1 and the same keys scattered over
+            // the whole int range
+            vector<int> dense(n), scattered(n);
+            for (size_t i = 0; i < n; i++) {
+                dense[i] = rng() % distinct;
+                scattered[i] = (int)((uint32_t)dense[i] * 2654435761u);
+            }
+
+            Frequencies ref = frequenciesOf(scattered, CountStrategy::HASH);
+            bool ok = true;
+            auto check = [&](const Frequencies& f) { ok = ok && f == ref; };
+
+            cout << setw(10) << n << setw(10) << distinct;
+            if ((double)n * distinct <= 2e9) {
+                vector<vector<int>> old;
+                cout << setw(10) << msFor([&] { old = oldCountFrequencies(scattered); });
+                Frequencies flat;
+                for (auto& v : old) flat.push_back({v[0], v[1]});
+                check(flat);
+            } else {
+                cout << setw(10) << "-";
+            }
+
+            Frequencies f;
+            cout << setw(10) << msFor([&] { f = withStdMap<map<int, int>>(scattered); });
+            check(f);
+            cout << setw(10) << msFor([&] { f = withStdMap<unordered_map<int, int>>(scattered); });
+            check(f);
+            cout << setw(10) << msFor([&] { f = frequenciesOf(scattered, CountStrategy::HASH); });
+            cout << setw(10) << msFor([&] { f = frequenciesOf(scattered, CountStrategy::RADIX); });
+            check(f);
+            cout << setw(10) << msFor([&] { f = frequenciesOf(scattered); });
+            check(f);
+
+            Frequencies d;
+            cout << setw(10) << msFor([&] { d = frequenciesOf(dense, CountStrategy::DENSE); });
+            ok = ok && d.size() == ref.size();
+            cout << (ok ? "" : "  MISMATCH") << endl;
+        }
+    }
+
+    cout << "== frequenciesParallel, n = " << maxN << " (cores: "
+         << thread::hardware_concurrency() << ")\n";
+    cout << setw(10) << "threads" << setw(16) << "1000 distinct" << setw(16)
+         << "n distinct" << "\n";
+    vector<int> low(maxN), high(maxN);
+    for (size_t i = 0; i < maxN; i++) {
+        low[i] = (int)((uint32_t)(rng() % 1000) * 2654435761u);
+        high[i] = (int)((uint32_t)(rng() % maxN) * 2654435761u);
+    }
+    Frequencies refLow = frequenciesOf(low, CountStrategy::HASH);
+    Frequencies refHigh = frequenciesOf(high, CountStrategy::HASH);
+    double baseLow = 0, baseHigh = 0;
+    for (int t = 1; t <= 64; t *= 2) {
+        Frequencies f;
+        double l = msFor([&] { f = frequenciesParallel(low, t); });
+        bool ok = f == refLow;
+        double h = msFor([&] { f = frequenciesParallel(high, t); });
+        ok = ok && f == refHigh;
+        if (t == 1) baseLow = l, baseHigh = h;
+        cout << setw(10) << t << setw(9) << l << " (" << setprecision(2)
+             << baseLow / l << "x)" << setprecision(1) << setw(9) << h << " ("
+             << setprecision(2) << baseHigh / h << "x)" << setprecision(1)
+             << (ok ? "" : "  MISMATCH") << endl;
+    }
+
+    // result memory: q1's vector<vector<int>> vs Frequencies
+    size_t keys = 1000000;
+    cout << "result for " << keys << " distinct keys: vector<vector<int>> ~"
+         << keys * (sizeof(vector<int>) + 32) / (1 << 20) << " MB (24 B + a "
+         << "32 B heap block each), Frequencies "
+         << keys * sizeof(array<int, 2>) / (1 << 20) << " MB\n";
+    return 0;
+}
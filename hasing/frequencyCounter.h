@@ -0,0 +1,374 @@
+#pragma once
+#include <bits/stdc++.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+========================================
+ FREQUENCY COUNTER
+----------------------------------------
+ FrequencyCounter<T>: one pass, flat open addressing
+   - distinct keys live in one vector in first-occurrence order
+     ({key, count}), so reading them back in q1.cpp's order is free
+   - the table itself is a byte of hash tag + a 32-bit index per
+     slot, in groups of 16: one SSE2 compare checks a whole group
+     (tag bytes: 0x80 = empty, else 7 bits of the hash)
+   - no deletes, load factor <= 7/8
+
+ frequenciesOf(vector<int>) picks a strategy:
+   DENSE : max - min small -> plain count array indexed by key
+   RADIX : huge input, mostly distinct keys -> radix sort
+           (key, position) pairs, run-length encode, put the runs
+           back in first-occurrence order
+   HASH  : everything else
+ frequenciesParallel(vector<int>, threads): same result, keys split
+ across threads by hash so each thread owns its counters outright
+
+ Results are vector<array<int, 2>>: it[0] = key, it[1] = count, the
+ same indexing as q1's vector<vector<int>>, at 8 bytes per key
+ instead of a heap-allocated vector each.
+========================================
+*/
+
+template <class T>
+struct FlatHash {
+    uint64_t operator()(const T& key) const {
+        uint64_t h = std::hash<T>{}(key) * 0x9E3779B97F4A7C15ull;
+        return h ^ (h >> 32);   // std::hash<int> is the identity
+    }
+};
+
+template <class T, class Hash = FlatHash<T>>
+class FrequencyCounter {
+public:
+    struct Entry {
+        T key;
+        uint64_t count;
+    };
+
+    explicit FrequencyCounter(size_t expected = 0) {
+        rehash(std::max<size_t>(GROUP, capacityFor(expected)));
+    }
+
+    // Count n more of key, returns the new count
+    uint64_t add(const T& key, uint64_t n = 1) {
+        uint64_t h = Hash{}(key);
+        size_t slot = find(key, h);
+        if (tags[slot] != EMPTY) return entries[slots[slot]].count += n;
+        return insert(key, h, slot, n);
+    }
+
+    uint64_t count(const T& key) const {
+        size_t slot = find(key, Hash{}(key));
+        return tags[slot] == EMPTY ? 0 : entries[slots[slot]].count;
+    }
+
+    size_t size() const { return entries.size(); }
+
+    // distinct keys in the order they were first added
+    const std::vector<Entry>& items() const { return entries; }
+
+    void clear() {
+        entries.clear();
+        std::fill(tags.begin(), tags.end(), EMPTY);
+    }
+
+    void reserve(size_t n) {
+        size_t cap = capacityFor(n);
+        if (cap > tags.size()) rehash(cap);
+    }
+
+    // bytes held, for comparing against other containers
+    size_t memoryBytes() const {
+        return entries.capacity() * sizeof(Entry) + tags.capacity() +
+               slots.capacity() * sizeof(uint32_t);
+    }
+
+private:
+    static constexpr size_t GROUP = 16;
+    static constexpr uint8_t EMPTY = 0x80;
+
+    std::vector<Entry> entries;
+    std::vector<uint8_t> tags;
+    std::vector<uint32_t> slots;
+    int shift = 64;   // group = hash >> shift
+
+    static uint8_t tagOf(uint64_t h) { return h & 0x7f; }
+
+    // new key, kept out of line so add() stays small enough to inline
+    __attribute__((noinline)) uint64_t insert(const T& key, uint64_t h,
+                                              size_t slot, uint64_t n) {
+        if ((entries.size() + 1) * 8 > tags.size() * 7) {
+            rehash(tags.size() * 2);
+            slot = find(key, h);
+        }
+        tags[slot] = tagOf(h);
+        slots[slot] = (uint32_t)entries.size();
+        entries.push_back({key, n});
+        return n;
+    }
+
+    static size_t capacityFor(size_t n) {
+        size_t cap = GROUP;
+        while (cap * 7 < n * 8) cap *= 2;
+        return cap;
+    }
+
+    // bit i set <=> group[i] == tag
+    static uint32_t match(const uint8_t* group, uint8_t tag) {
+#if defined(__SSE2__)
+        __m128i g = _mm_loadu_si128((const __m128i*)group);
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8((char)tag)));
+#else
+        uint32_t m = 0;
+        for (size_t i = 0; i < GROUP; i++) m |= (uint32_t)(group[i] == tag) << i;
+        return m;
+#endif
+    }
+
+    /*
+     Slot holding key, or the empty slot where it would go.
+     Groups are probed 1, 2, 3.. apart (triangular), which visits
+     every group of a power-of-two table.
+    */
+    size_t find(const T& key, uint64_t h) const {
+        size_t groups = tags.size() / GROUP;
+        size_t g = shift == 64 ? 0 : h >> shift;
+        uint8_t tag = tagOf(h);
+        for (size_t step = 1;; step++) {
+            const uint8_t* base = tags.data() + g * GROUP;
+            for (uint32_t m = match(base, tag); m; m &= m - 1) {
+                size_t slot = g * GROUP + __builtin_ctz(m);
+                if (entries[slots[slot]].key == key) return slot;
+            }
+            if (uint32_t e = match(base, EMPTY)) return g * GROUP + __builtin_ctz(e);
+            g = (g + step) & (groups - 1);
+        }
+    }
+
+    void rehash(size_t capacity) {
+        tags.assign(capacity, EMPTY);
+        slots.assign(capacity, 0);
+        shift = 64 - __builtin_ctzll(capacity / GROUP);
+        for (uint32_t i = 0; i < entries.size(); i++) {
+            uint64_t h = Hash{}(entries[i].key);
+            size_t slot = find(entries[i].key, h);
+            tags[slot] = tagOf(h);
+            slots[slot] = i;
+        }
+    }
+};
+
+/* ---------- Integer keys: strategies ---------- */
+
+using Frequencies = std::vector<std::array<int, 2>>;
+
+enum class CountStrategy { AUTO, HASH, DENSE, RADIX };
+
+inline Frequencies frequenciesHash(const std::vector<int>& nums) {
+    FrequencyCounter<int> counter;
+    for (int x : nums) counter.add(x);
+    Frequencies out;
+    out.reserve(counter.size());
+    for (auto& e : counter.items()) out.push_back({e.key, (int)e.count});
+    return out;
+}
+
+// keys in [lo, hi]
+inline Frequencies frequenciesDense(const std::vector<int>& nums, int lo, int hi) {
+    std::vector<uint32_t> counts((size_t)((int64_t)hi - lo + 1));
+    std::vector<int> order;
+    for (int x : nums)
+        if (counts[(int64_t)x - lo]++ == 0) order.push_back(x);
+    Frequencies out;
+    out.reserve(order.size());
+    for (int x : order) out.push_back({x, (int)counts[(int64_t)x - lo]});
+    return out;
+}
+
+// Stable LSD radix sort of a on its high 32 bits, 8 bits per pass
+inline void radixSortHigh32(std::vector<uint64_t>& a, std::vector<uint64_t>& tmp) {
+    tmp.resize(a.size());
+    for (int shift = 32; shift < 64; shift += 8) {
+        size_t bucket[257] = {0};
+        for (uint64_t v : a) bucket[((v >> shift) & 0xff) + 1]++;
+        if (bucket[1] == a.size()) continue;   // all in bucket 0: nothing moves
+        for (int i = 0; i < 256; i++) bucket[i + 1] += bucket[i];
+        for (uint64_t v : a) tmp[bucket[(v >> shift) & 0xff]++] = v;
+        a.swap(tmp);
+    }
+}
+
+inline Frequencies frequenciesRadix(const std::vector<int>& nums) {
+    // (key with the sign bit flipped, so it sorts as unsigned | position)
+    std::vector<uint64_t> a(nums.size()), tmp;
+    for (size_t i = 0; i < nums.size(); i++)
+        a[i] = (uint64_t)((uint32_t)nums[i] ^ 0x80000000u) << 32 | i;
+    radixSortHigh32(a, tmp);
+
+    // runs of one key; stable sort keeps the first position in front.
+    // Reuse a as (first position | run number), counts go to runLength.
+    std::vector<uint32_t> runLength;
+    size_t runs = 0;
+    for (size_t i = 0; i < a.size();) {
+        size_t j = i;
+        uint64_t key = a[i] >> 32;
+        while (j < a.size() && a[j] >> 32 == key) j++;
+        runLength.push_back((uint32_t)(j - i));
+        a[runs++] = (a[i] & 0xffffffffu) << 32 | (runLength.size() - 1);
+        i = j;
+    }
+    a.resize(runs);
+    radixSortHigh32(a, tmp);   // back into first-occurrence order
+
+    Frequencies out(runs);
+    for (size_t r = 0; r < runs; r++) {
+        uint32_t pos = (uint32_t)(a[r] >> 32);
+        out[r] = {nums[pos], (int)runLength[(uint32_t)a[r]]};
+    }
+    return out;
+}
+
+/*
+ Count every key of nums, in first-occurrence order.
+ AUTO: DENSE when the key range is at most ~2 * n, RADIX when there
+ are 4M+ keys and a 64K sample is mostly distinct, HASH otherwise.
+*/
+inline Frequencies frequenciesOf(const std::vector<int>& nums,
+                                 CountStrategy strategy = CountStrategy::AUTO) {
+    if (nums.empty()) return {};
+    auto [lo, hi] = std::minmax_element(nums.begin(), nums.end());
+    int64_t range = (int64_t)*hi - *lo + 1;
+
+    if (strategy == CountStrategy::AUTO) {
+        const size_t RADIX_MIN = 1 << 22, SAMPLE = 1 << 16;
+        if (range <= 2 * (int64_t)std::max<size_t>(nums.size(), 1 << 16) &&
+            range <= (1 << 28)) {
+            strategy = CountStrategy::DENSE;
+        } else if (nums.size() >= RADIX_MIN) {
+            FrequencyCounter<int> sample(SAMPLE);
+            for (size_t i = 0; i < SAMPLE; i++) sample.add(nums[i]);
+            strategy = sample.size() > SAMPLE / 2 ? CountStrategy::RADIX
+                                                  : CountStrategy::HASH;
+        } else {
+            strategy = CountStrategy::HASH;
+        }
+    }
+
+    switch (strategy) {
+        case CountStrategy::DENSE: return frequenciesDense(nums, *lo, *hi);
+        case CountStrategy::RADIX: return frequenciesRadix(nums);
+        default: return frequenciesHash(nums);
+    }
+}
+
+/* ---------- Parallel: hash-partitioned by key ---------- */
+
+// f(t) on `threads` threads (t = 0 runs on the caller)
+template <class F>
+void runThreads(int threads, F f) {
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++) pool.emplace_back(f, t);
+    f(0);
+    for (auto& th : pool) th.join();
+}
+
+/*
+ Same result as frequenciesOf(), counted on `threads` threads.
+ Thread t owns every key whose hash lands in partition t, so no two
+ threads ever touch one counter:
+
+ 1. each thread histograms its slice of the input by partition;
+    prefix sums give every (partition, slice) pair its own range
+ 2. each thread copies (key, position) of its slice into those ranges:
+    partition p is now one run of the input, in position order
+ 3. thread p counts partition p in its own FrequencyCounter and marks
+    the position where each key first showed up with (p, its index)
+ 4. each thread compacts its slice of those marks into the output;
+    order of positions = first-occurrence order
+ Up to 256 threads (the partition is kept in a byte).
+*/
+inline Frequencies frequenciesParallel(const std::vector<int>& nums, int threads) {
+    size_t n = nums.size();
+    threads = (int)std::max<size_t>(1, std::min<size_t>({(size_t)threads, n / 4096, 256}));
+    if (threads == 1) return frequenciesOf(nums, CountStrategy::HASH);
+
+    const int P = threads;
+    auto partitionOf = [P](int key) {
+        return (int)(((uint64_t)(uint32_t)FlatHash<int>{}(key) * P) >> 32);
+    };
+    auto slice = [&](int t) {
+        return std::make_pair(n * t / threads, n * (t + 1) / threads);
+    };
+
+    // 1. offsets[p * threads + t] = where slice t's keys of partition p go;
+    //    each thread counts into its own histogram and stores it once, so
+    //    neighbouring threads never write one cache line per element
+    std::vector<size_t> offsets((size_t)P * threads);
+    runThreads(threads, [&](int t) {
+        std::vector<size_t> local(P);
+        auto [b, e] = slice(t);
+        for (size_t i = b; i < e; i++) local[partitionOf(nums[i])]++;
+        for (int p = 0; p < P; p++) offsets[(size_t)p * threads + t] = local[p];
+    });
+    std::vector<size_t> partStart(P + 1);
+    size_t sum = 0;
+    for (int p = 0; p < P; p++) {
+        partStart[p] = sum;
+        for (int t = 0; t < threads; t++) {
+            size_t c = offsets[(size_t)p * threads + t];
+            offsets[(size_t)p * threads + t] = sum;
+            sum += c;
+        }
+    }
+    partStart[P] = sum;
+
+    // 2. scatter
+    std::vector<std::pair<int, uint32_t>> scattered(n);
+    runThreads(threads, [&](int t) {
+        std::vector<size_t> at(P);
+        for (int p = 0; p < P; p++) at[p] = offsets[(size_t)p * threads + t];
+        auto [b, e] = slice(t);
+        for (size_t i = b; i < e; i++)
+            scattered[at[partitionOf(nums[i])]++] = {nums[i], (uint32_t)i};
+    });
+
+    // 3. count per partition
+    const uint32_t NONE = UINT32_MAX;
+    std::vector<uint32_t> first(n, NONE);
+    std::vector<uint8_t> firstPart(n);
+    std::vector<FrequencyCounter<int>> counters(P);
+    runThreads(threads, [&](int p) {
+        FrequencyCounter<int>& c = counters[p];
+        for (size_t i = partStart[p]; i < partStart[p + 1]; i++) {
+            auto [key, pos] = scattered[i];
+            if (c.add(key) == 1) {
+                first[pos] = (uint32_t)(c.size() - 1);
+                firstPart[pos] = (uint8_t)p;
+            }
+        }
+    });
+
+    // 4. compact, slices in parallel
+    std::vector<size_t> sliceCount(threads), sliceStart(threads + 1);
+    runThreads(threads, [&](int t) {
+        auto [b, e] = slice(t);
+        size_t c = 0;
+        for (size_t i = b; i < e; i++) c += first[i] != NONE;
+        sliceCount[t] = c;
+    });
+    for (int t = 0; t < threads; t++) sliceStart[t + 1] = sliceStart[t] + sliceCount[t];
+
+    Frequencies out(sliceStart[threads]);
+    runThreads(threads, [&](int t) {
+        size_t o = sliceStart[t];
+        auto [b, e] = slice(t);
+        for (size_t i = b; i < e; i++) {
+            if (first[i] == NONE) continue;
+            auto& entry = counters[firstPart[i]].items()[first[i]];
+            out[o++] = {entry.key, (int)entry.count};
+        }
+    });
+    return out;
+}
@@ -1,27 +1,21 @@
 #include <bits/stdc++.h>
 
-using namespace std;
+#include "frequencyCounter.h"
 
-int frequenciesMapper(int num, vector<int> &arr);
+using namespace std;
 
 int main(){
     vector<int> v = {5, 3, 5, 2, 8, 3, 3, 5, 1, 8};
-    map<int, int> map2;
+    FrequencyCounter<int> counter;
     for(int vals : v){
-        map2[vals] = frequenciesMapper(vals , v);
-    }
-    
-    for(auto it: map2){
-        cout << it.first << " " << it.second << endl;
+        counter.add(vals);
     }
-}
 
-int frequenciesMapper(int num, vector<int> &arr){
-    int count = 0;
-    for (int val : arr){
-        if(val == num){
-            count++;
-        }
+    // printed by key, like the std::map this used to fill
+    vector<FrequencyCounter<int>::Entry> sorted = counter.items();
+    sort(sorted.begin(), sorted.end(),
+         [](auto& a, auto& b) { return a.key < b.key; });
+    for(auto it: sorted){
+        cout << it.key << " " << it.count << endl;
     }
-    return count;
-}
\ No newline at end of file
+}
@@ -0,0 +1,122 @@
+#include <bits/stdc++.h>
+
+#include "heavyHitters.h"
+
+using namespace std;
+
+/*
+========================================
+ HEAVY HITTERS over stdin
+----------------------------------------
+ Whitespace-separated tokens from stdin are the events. Memory stays
+ fixed (set by -e / -d) however long the stream runs.
+
+ usage: ./heavyHitters [k] [-e epsilon] [-d delta] [-r every]
+   k        how many to report           (default 10)
+   -e       error bound, share of events (default 0.001)
+   -d       failure probability          (default 0.001)
+   -r       also report every N events   (default: only at the end)
+
+ ./heavyHitters bench   -> accuracy vs memory against FrequencyCounter
+========================================
+*/
+
+void report(const HeavyHitters<string>& hh, size_t k) {
+    cout << "after " << hh.events() << " events:\n";
+    for (auto& h : hh.top(k))
+        cout << "  " << h.key << " ~" << h.estimate << " (>= " << h.lower << ")\n";
+    cout << flush;
+}
+
+/* ---------- Benchmark ---------- */
+
+// Zipf(s) over 1..universe
+struct Zipf {
+    vector<double> cdf;
+    Zipf(int universe, double s) : cdf(universe) {
+        double sum = 0;
+        for (int i = 0; i < universe; i++) cdf[i] = sum += 1 / pow(i + 1, s);
+        for (auto& c : cdf) c /= sum;
+    }
+    int operator()(mt19937_64& rng) {
+        double u = uniform_real_distribution<double>(0, 1)(rng);
+        return int(lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin()) + 1;
+    }
+};
+
+void bench() {
+    const size_t N = 10000000, K = 100;
+    const int UNIVERSE = 1000000;
+    mt19937_64 rng(3);
+
+    cout << fixed << setprecision(3);
+    for (double s : {0.8, 1.1}) {
+        Zipf zipf(UNIVERSE, s);
+        vector<int> stream(N);
+        for (auto& x : stream) x = zipf(rng);
+
+        FrequencyCounter<int> exact;
+        for (int x : stream) exact.add(x);
+        vector<FrequencyCounter<int>::Entry> truth = exact.items();
+        sort(truth.begin(), truth.end(),
+             [](auto& a, auto& b) { return a.count > b.count; });
+        set<int> trueTop;
+        for (size_t i = 0; i < K; i++) trueTop.insert(truth[i].key);
+
+        cout << "== zipf s=" << s << ", " << N << " events, " << exact.size()
+             << " distinct; exact counter " << exact.memoryBytes() / 1024
+             << " KB\n";
+        cout << setw(10) << "epsilon" << setw(12) << "memory KB" << setw(14)
+             << "top-" << K << " recall" << setw(16) << "mean rel err"
+             << setw(14) << "max abs err" << setw(12) << "eps*N" << "\n";
+
+        for (double eps : {1e-2, 1e-3, 1e-4}) {
+            HeavyHitters<int> hh(eps, 1e-3);
+            for (int x : stream) hh.add(x);
+
+            size_t hit = 0;
+            double relErr = 0;
+            uint64_t maxErr = 0;
+            auto top = hh.top(K);
+            for (auto& h : top) {
+                hit += trueTop.count(h.key);
+                uint64_t real = exact.count(h.key);
+                relErr += (double)(h.estimate - real) / real;
+                maxErr = max(maxErr, h.estimate - real);
+            }
+            cout << setw(10) << defaultfloat << eps << fixed << setw(12)
+                 << hh.memoryBytes() / 1024
+                 << setw(18) << (double)hit / K << setw(16)
+                 << relErr / top.size() << setw(14) << maxErr << setw(12)
+                 << (uint64_t)(eps * N) << "\n";
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && string(argv[1]) == "bench") {
+        bench();
+        return 0;
+    }
+
+    size_t k = 10;
+    double epsilon = 0.001, delta = 0.001;
+    uint64_t every = 0;
+    for (int i = 1; i < argc; i++) {
+        string a = argv[i];
+        if (a == "-e" && i + 1 < argc) epsilon = atof(argv[++i]);
+        else if (a == "-d" && i + 1 < argc) delta = atof(argv[++i]);
+        else if (a == "-r" && i + 1 < argc) every = strtoull(argv[++i], nullptr, 10);
+        else k = stoul(a);
+    }
+
+    ios::sync_with_stdio(false);
+    HeavyHitters<string> hh(epsilon, delta);
+    string token;
+    while (cin >> token) {
+        hh.add(token);
+        if (every && hh.events() % every == 0) report(hh, k);
+    }
+    report(hh, k);
+    return 0;
+}
@@ -0,0 +1,229 @@
+#pragma once
+#include <bits/stdc++.h>
+
+#include "frequencyCounter.h"
+
+/*
+========================================
+ HEAVY HITTERS (bounded memory)
+----------------------------------------
+ For streams where keeping a count per distinct key (FrequencyCounter)
+ grows without limit.
+
+ CountMinSketch(epsilon, delta)
+   depth x width counters, width = e / epsilon, depth = ln(1 / delta).
+   estimate(key) >= true count, and <= true count + epsilon * N
+   with probability 1 - delta (N = events so far). Conservative
+   update: only the rows at the minimum are raised.
+
+ SpaceSaving<T>(capacity)
+   tracks `capacity` keys; a new key evicts the smallest and inherits
+   its count (remembered as `error`). Any key with more than
+   N / capacity events is guaranteed to be tracked;
+   count - error <= true count <= count.
+
+ HeavyHitters<T>(epsilon, delta)
+   both: Space-Saving with 1 / epsilon slots finds the candidates, the
+   estimate is min(Space-Saving count, Count-Min estimate) since both
+   only ever overcount. Memory is fixed by epsilon and delta.
+========================================
+*/
+
+class CountMinSketch {
+public:
+    CountMinSketch(double epsilon, double delta) {
+        width = 1;
+        while (width < std::ceil(std::exp(1.0) / epsilon)) width *= 2;
+        depth = std::max(1, (int)std::ceil(std::log(1 / delta)));
+        cells.assign(width * depth, 0);
+    }
+
+    // h: a 64-bit hash of the key; returns the new estimate
+    uint64_t add(uint64_t h, uint64_t n = 1) {
+        uint64_t est = estimate(h);
+        uint64_t want = est + n;
+        uint64_t h2 = step(h);
+        for (int r = 0; r < depth; r++) {
+            uint64_t& c = cells[r * width + ((h + r * h2) & (width - 1))];
+            c = std::max(c, want);
+        }
+        total += n;
+        return want;
+    }
+
+    uint64_t estimate(uint64_t h) const {
+        uint64_t h2 = step(h), best = UINT64_MAX;
+        for (int r = 0; r < depth; r++)
+            best = std::min(best, cells[r * width + ((h + r * h2) & (width - 1))]);
+        return best;
+    }
+
+    uint64_t events() const { return total; }
+    size_t memoryBytes() const { return cells.size() * sizeof(uint64_t); }
+
+private:
+    size_t width;
+    int depth;
+    std::vector<uint64_t> cells;
+    uint64_t total = 0;
+
+    // rows use h + r * h2 (double hashing); h2 odd so rows differ
+    static uint64_t step(uint64_t h) {
+        return ((h >> 29) ^ (h * 0xBF58476D1CE4E5B9ull)) | 1;
+    }
+};
+
+template <class T, class Hash = std::hash<T>>
+class SpaceSaving {
+public:
+    struct Item {
+        T key;
+        uint64_t count;
+        uint64_t error;   // count it inherited when it took the slot
+    };
+
+    explicit SpaceSaving(size_t capacity) : capacity(std::max<size_t>(1, capacity)) {
+        items.reserve(this->capacity);
+        heap.reserve(this->capacity);
+        pos.reserve(this->capacity);
+        index.reserve(this->capacity);
+    }
+
+    void add(const T& key, uint64_t n = 1) {
+        auto it = index.find(key);
+        if (it != index.end()) {
+            items[it->second].count += n;
+            down(pos[it->second]);
+            return;
+        }
+        if (items.size() < capacity) {
+            size_t i = items.size();
+            items.push_back({key, n, 0});
+            index.emplace(key, i);
+            pos.push_back(heap.size());
+            heap.push_back(i);
+            up(heap.size() - 1);
+            return;
+        }
+        // evict the smallest, the newcomer takes over its count
+        size_t i = heap[0];
+        index.erase(items[i].key);
+        uint64_t floor = items[i].count;
+        items[i] = {key, floor + n, floor};
+        index.emplace(key, i);
+        down(0);
+    }
+
+    // tracked keys, largest count first
+    std::vector<Item> top(size_t k) const {
+        std::vector<Item> out = items;
+        k = std::min(k, out.size());
+        std::partial_sort(out.begin(), out.begin() + k, out.end(),
+                          [](const Item& a, const Item& b) { return a.count > b.count; });
+        out.resize(k);
+        return out;
+    }
+
+    const Item* find(const T& key) const {
+        auto it = index.find(key);
+        return it == index.end() ? nullptr : &items[it->second];
+    }
+
+    // approximate: items + heap + hash index nodes
+    size_t memoryBytes() const {
+        return capacity * (sizeof(Item) + 2 * sizeof(size_t) +
+                           sizeof(std::pair<T, size_t>) + 2 * sizeof(void*));
+    }
+
+private:
+    size_t capacity;
+    std::vector<Item> items;
+    std::vector<size_t> heap;   // min-heap of item indices by count
+    std::vector<size_t> pos;    // pos[item] = its place in heap
+    std::unordered_map<T, size_t, Hash> index;
+
+    bool less(size_t a, size_t b) const {
+        return items[heap[a]].count < items[heap[b]].count;
+    }
+
+    void swapAt(size_t a, size_t b) {
+        std::swap(heap[a], heap[b]);
+        pos[heap[a]] = a;
+        pos[heap[b]] = b;
+    }
+
+    void up(size_t i) {
+        while (i > 0 && less(i, (i - 1) / 2)) {
+            swapAt(i, (i - 1) / 2);
+            i = (i - 1) / 2;
+        }
+    }
+
+    void down(size_t i) {
+        while (true) {
+            size_t l = 2 * i + 1, r = l + 1, m = i;
+            if (l < heap.size() && less(l, m)) m = l;
+            if (r < heap.size() && less(r, m)) m = r;
+            if (m == i) return;
+            swapAt(i, m);
+            i = m;
+        }
+    }
+};
+
+template <class T, class Hash = FlatHash<T>>
+class HeavyHitters {
+public:
+    struct Hitter {
+        T key;
+        uint64_t estimate;   // >= true count
+        uint64_t lower;      // <= true count
+    };
+
+    HeavyHitters(double epsilon, double delta)
+        : sketch(epsilon, delta), candidates((size_t)std::ceil(1 / epsilon)) {}
+
+    void add(const T& key, uint64_t n = 1) {
+        sketch.add(Hash{}(key), n);
+        candidates.add(key, n);
+    }
+
+    uint64_t events() const { return sketch.events(); }
+
+    // the k largest, by estimate
+    std::vector<Hitter> top(size_t k) const {
+        std::vector<Hitter> out;
+        for (auto& item : candidates.top(SIZE_MAX)) {
+            uint64_t est = std::min(item.count, sketch.estimate(Hash{}(item.key)));
+            out.push_back({item.key, est, item.count - item.error});
+        }
+        k = std::min(k, out.size());
+        std::partial_sort(out.begin(), out.begin() + k, out.end(),
+                          [](const Hitter& a, const Hitter& b) {
+                              return a.estimate > b.estimate;
+                          });
+        out.resize(k);
+        return out;
+    }
+
+    // keys estimated above phi * events()
+    std::vector<Hitter> heavy(double phi) const {
+        std::vector<Hitter> out = top(SIZE_MAX);
+        while (!out.empty() && out.back().estimate <= phi * events()) out.pop_back();
+        return out;
+    }
+
+    uint64_t estimate(const T& key) const {
+        uint64_t est = sketch.estimate(Hash{}(key));
+        if (auto* item = candidates.find(key)) est = std::min(est, item->count);
+        return est;
+    }
+
+    size_t memoryBytes() const {
+        return sketch.memoryBytes() + candidates.memoryBytes();
+    }
+
+private:
+    CountMinSketch sketch;
+    SpaceSaving<T> candidates;
+};
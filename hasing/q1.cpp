@@ -1,29 +1,16 @@
 // Online C++ compiler to run C++ program online
 #include <bits/stdc++.h>
 
-using namespace std;
+#include "frequencyCounter.h"
 
-int count(vector<int>& nums, int num){
-    int count = 0;
-    for(auto it : nums){
-        if(num == it){
-            count++;
-        }
-    }
-    return count;
-} 
+using namespace std;
 
-// vector<vector<int>>
+// The problem's signature over frequenciesOf(): vector<vector<int>>,
+// first-occurrence order
 vector<vector<int>> countFrequencies(vector<int>& nums) {
     vector<vector<int>> v;
-    set<int> alreadythere;
-    for (auto it : nums){
-        if(alreadythere.find(it) != alreadythere.end()){
-            continue;
-        }
-        alreadythere.insert(it);
-        int numCount = count(nums, it);
-        v.push_back({it, numCount});
+    for (auto& it : frequenciesOf(nums)) {
+        v.push_back({it[0], it[1]});
     }
     return v;
 }
@@ -1,4 +1,8 @@
 #include <bits/stdc++.h>
+#include "bitAnalytics.h"
+#include "permutations.h"
+#include "soaPairs.h"
+#include "sorting.h"
 using namespace std;
 
 /*
@@ -33,6 +37,23 @@ int main() {
         cout << p.first << " -> " << p.second << "\n";
     }
 
+    /* ---------- LARGE SORTS (sorting.h, see sortBench.cpp) ---------- */
+
+    // same orders as the two sorts above, for millions of elements;
+    // shown on fresh unsorted copies, checked against sort's result
+    vector<int> w = {1, 6, 3, 9, 2};
+    radixSort(w.data(), w.size(), true);       // greater<int>()
+
+    pair<int,int> b[] = {{1,2}, {2,1}, {4,1}};
+    radixSortPairs(b, n);                      // comp
+
+    pair<int,int> c[] = {{1,2}, {2,1}, {4,1}};
+    parallelSort(c, n, comp, 4);               // any comparator
+
+    cout << "radixSort / radixSortPairs / parallelSort same as sort: "
+         << (w == v && equal(a, a + n, b) && equal(a, a + n, c) ? "yes" : "no")
+         << "\n";
+
     for (int x : v) {
         cout << x << " ";
     }
@@ -48,6 +69,11 @@ int main() {
     cout << "__builtin_popcountll(num2): "
          << __builtin_popcountll(num2) << "\n";
 
+    // whole buffers: bulk kernels picked for this CPU (bitAnalytics.h)
+    uint64_t words[] = {7, 12312312345ULL, ~0ULL};
+    cout << "popcount(words): " << popcount(words, 3)
+         << ", popcountAnd(words, words + 1, 2): " << popcountAnd(words, words + 1, 2) << "\n";
+
     /* ---------- PERMUTATIONS ---------- */
 
     string s = "123";
@@ -55,9 +81,22 @@ int main() {
         cout << s << "\n";
     } while (next_permutation(s.begin(), s.end()));
 
+    // the same orderings as a ranked space (permutations.h): jump
+    // straight to rank k, or walk any range [lo, hi) of ranks - one
+    // range per thread, see permutationBench.cpp
+    PermutationSpace<char> perms({'1', '2', '3'});
+    char p[3];
+    perms.unrank(3, p);
+    cout << "rank 3 of " << perms.size() << ": " << string(p, 3) << "\n";
+    cout << "ranks [4, 6):";
+    perms.forEach(4, 6, [&](const char* q) { cout << " " << string(q, 3); });
+    cout << "\n";
+
     /* ---------- MAX ELEMENT ---------- */
 
-    int maxi = max({a[0].first, a[1].first, a[2].first});
+    // one column, scanned on its own (soaPairs.h)
+    SoAPairs<int,int> cols(a, a + n);
+    int maxi = cols.maxFirst();
     cout << "Max first element: " << maxi << "\n";
 
     return 0;
@@ -0,0 +1,354 @@
+#pragma once
+#include <bits/stdc++.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/*
+========================================
+ BIT ANALYTICS
+----------------------------------------
+ popcount(words, n)          set bits in n 64-bit words
+ popcountAnd(a, b, n)        set bits of a & b, without storing a & b
+                             (intersection size of two bitsets)
+ Kernels, best first, picked once per process from the CPU:
+   AVX512 : vpopcntq on 512-bit lanes (AVX-512 VPOPCNTDQ)
+   AVX2   : Harley-Seal: a carry-save adder tree folds 16 vectors
+            into ones/twos/fours/eights/sixteens, so only one vector
+            in 16 is actually counted (nibble table via vpshufb, summed
+            with vpsadbw)
+   POPCNT : the popcnt instruction, 4 independent accumulators
+   SCALAR : __builtin_popcountll as compiled without -mpopcnt
+            (a bit-trick call per word)
+
+ RankSelect(words, nbits)    read-only index: 25% of the bits, plus
+                             16 bytes per 512 ones, plus 8 bytes per
+                             one in sparse stretches (at most another
+                             25% of those bits)
+   rank(i)   : ones in [0, i), O(1). Each 512-bit block keeps its
+               absolute count plus 7 relative 9-bit word counts packed
+               in one more word (Vigna's rank9), so a query touches
+               two index words and one data word.
+   select(k) : position of the k-th one (from 0), O(1). Inventory
+               in the style of Vigna's select9: every 512 ones start a
+               stretch.
+               - sparse stretch (256 or more blocks): the positions of
+                 its 512 ones are stored, select is one lookup
+               - dense stretch: the block of every 64th one is kept as
+                 a byte offset, so a binary search over fewer than 256
+                 blocks (at most 8 steps, usually 0-1) finds the
+                 block, the packed counts the word, and pdep (BMI2)
+                 or a clear-lowest-bit loop the bit.
+========================================
+*/
+
+enum class PopcountKernel { SCALAR, POPCNT, AVX2, AVX512 };
+
+inline const char* kernelName(PopcountKernel k) {
+    switch (k) {
+        case PopcountKernel::AVX512: return "avx512";
+        case PopcountKernel::AVX2: return "avx2";
+        case PopcountKernel::POPCNT: return "popcnt";
+        default: return "scalar";
+    }
+}
+
+inline PopcountKernel bestPopcountKernel() {
+    static const PopcountKernel best = [] {
+#if defined(__x86_64__) || defined(__i386__)
+        if (__builtin_cpu_supports("avx512vpopcntdq")) return PopcountKernel::AVX512;
+        if (__builtin_cpu_supports("avx2")) return PopcountKernel::AVX2;
+        if (__builtin_cpu_supports("popcnt")) return PopcountKernel::POPCNT;
+#endif
+        return PopcountKernel::SCALAR;
+    }();
+    return best;
+}
+
+/* ---------- Kernels ---------- */
+
+// And: count a & b, else a alone (b unused)
+template <bool And>
+uint64_t popcountScalar(const uint64_t* a, const uint64_t* b, size_t n) {
+    uint64_t total = 0;
+    for (size_t i = 0; i < n; i++) total += __builtin_popcountll(And ? a[i] & b[i] : a[i]);
+    return total;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+template <bool And>
+__attribute__((target("popcnt"))) uint64_t popcountPopcnt(const uint64_t* a,
+                                                          const uint64_t* b, size_t n) {
+    uint64_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        c0 += __builtin_popcountll(And ? a[i] & b[i] : a[i]);
+        c1 += __builtin_popcountll(And ? a[i + 1] & b[i + 1] : a[i + 1]);
+        c2 += __builtin_popcountll(And ? a[i + 2] & b[i + 2] : a[i + 2]);
+        c3 += __builtin_popcountll(And ? a[i + 3] & b[i + 3] : a[i + 3]);
+    }
+    for (; i < n; i++) c0 += __builtin_popcountll(And ? a[i] & b[i] : a[i]);
+    return c0 + c1 + c2 + c3;
+}
+
+// per 64-bit lane bit counts of v
+__attribute__((target("avx2"))) inline __m256i popcount256(__m256i v) {
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, low));
+    __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi32(v, 4), low));
+    return _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256());
+}
+
+// carry-save adder: (h, l) = a + b + c, bit by bit
+__attribute__((target("avx2"))) inline void csa(__m256i& h, __m256i& l, __m256i a,
+                                                __m256i b, __m256i c) {
+    __m256i u = _mm256_xor_si256(a, b);
+    h = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(u, c));
+    l = _mm256_xor_si256(u, c);
+}
+
+template <bool And>
+__attribute__((target("avx2"))) inline __m256i load256(const uint64_t* a, const uint64_t* b,
+                                                       size_t v) {
+    __m256i x = _mm256_loadu_si256((const __m256i*)(a + 4 * v));
+    if (And) x = _mm256_and_si256(x, _mm256_loadu_si256((const __m256i*)(b + 4 * v)));
+    return x;
+}
+
+template <bool And>
+__attribute__((target("avx2,popcnt"))) uint64_t popcountAvx2(const uint64_t* a,
+                                                             const uint64_t* b, size_t n) {
+    size_t vectors = n / 4, v = 0;
+    __m256i total = _mm256_setzero_si256();
+    __m256i ones = total, twos = total, fours = total, eights = total, sixteens;
+    __m256i twosA, twosB, foursA, foursB, eightsA, eightsB;
+    for (; v + 16 <= vectors; v += 16) {
+        csa(twosA, ones, ones, load256<And>(a, b, v), load256<And>(a, b, v + 1));
+        csa(twosB, ones, ones, load256<And>(a, b, v + 2), load256<And>(a, b, v + 3));
+        csa(foursA, twos, twos, twosA, twosB);
+        csa(twosA, ones, ones, load256<And>(a, b, v + 4), load256<And>(a, b, v + 5));
+        csa(twosB, ones, ones, load256<And>(a, b, v + 6), load256<And>(a, b, v + 7));
+        csa(foursB, twos, twos, twosA, twosB);
+        csa(eightsA, fours, fours, foursA, foursB);
+        csa(twosA, ones, ones, load256<And>(a, b, v + 8), load256<And>(a, b, v + 9));
+        csa(twosB, ones, ones, load256<And>(a, b, v + 10), load256<And>(a, b, v + 11));
+        csa(foursA, twos, twos, twosA, twosB);
+        csa(twosA, ones, ones, load256<And>(a, b, v + 12), load256<And>(a, b, v + 13));
+        csa(twosB, ones, ones, load256<And>(a, b, v + 14), load256<And>(a, b, v + 15));
+        csa(foursB, twos, twos, twosA, twosB);
+        csa(eightsB, fours, fours, foursA, foursB);
+        csa(sixteens, eights, eights, eightsA, eightsB);
+        total = _mm256_add_epi64(total, popcount256(sixteens));
+    }
+    total = _mm256_slli_epi64(total, 4);
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount256(eights), 3));
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount256(fours), 2));
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount256(twos), 1));
+    total = _mm256_add_epi64(total, popcount256(ones));
+    for (; v < vectors; v++) total = _mm256_add_epi64(total, popcount256(load256<And>(a, b, v)));
+
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256((__m256i*)lanes, total);
+    uint64_t sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (size_t i = vectors * 4; i < n; i++) sum += __builtin_popcountll(And ? a[i] & b[i] : a[i]);
+    return sum;
+}
+
+template <bool And>
+__attribute__((target("avx512f,avx512vpopcntdq,popcnt"))) uint64_t popcountAvx512(
+    const uint64_t* a, const uint64_t* b, size_t n) {
+    __m512i acc[4] = {_mm512_setzero_si512(), _mm512_setzero_si512(),
+                      _mm512_setzero_si512(), _mm512_setzero_si512()};
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        for (int k = 0; k < 4; k++) {
+            __m512i x = _mm512_loadu_si512(a + i + 8 * k);
+            if (And) x = _mm512_and_si512(x, _mm512_loadu_si512(b + i + 8 * k));
+            acc[k] = _mm512_add_epi64(acc[k], _mm512_popcnt_epi64(x));
+        }
+    }
+    __m512i s = _mm512_add_epi64(_mm512_add_epi64(acc[0], acc[1]), _mm512_add_epi64(acc[2], acc[3]));
+    alignas(64) uint64_t lanes[8];
+    _mm512_store_si512(lanes, s);
+    uint64_t sum = 0;
+    for (uint64_t l : lanes) sum += l;
+    for (; i < n; i++) sum += __builtin_popcountll(And ? a[i] & b[i] : a[i]);
+    return sum;
+}
+#endif
+
+template <bool And>
+uint64_t popcountWith(PopcountKernel k, const uint64_t* a, const uint64_t* b, size_t n) {
+#if defined(__x86_64__) || defined(__i386__)
+    switch (k) {
+        case PopcountKernel::AVX512: return popcountAvx512<And>(a, b, n);
+        case PopcountKernel::AVX2: return popcountAvx2<And>(a, b, n);
+        case PopcountKernel::POPCNT: return popcountPopcnt<And>(a, b, n);
+        default: break;
+    }
+#endif
+    return popcountScalar<And>(a, b, n);
+}
+
+inline uint64_t popcount(const uint64_t* words, size_t n,
+                         PopcountKernel k = bestPopcountKernel()) {
+    return popcountWith<false>(k, words, nullptr, n);
+}
+
+inline uint64_t popcountAnd(const uint64_t* a, const uint64_t* b, size_t n,
+                            PopcountKernel k = bestPopcountKernel()) {
+    return popcountWith<true>(k, a, b, n);
+}
+
+/* ---------- Rank / select ---------- */
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("bmi2"))) inline int selectInWordBmi2(uint64_t w, int r) {
+    return __builtin_ctzll(_pdep_u64(1ull << r, w));
+}
+#endif
+
+// position of the r-th (from 0) set bit of w; w has more than r
+inline int selectInWord(uint64_t w, int r) {
+#if defined(__x86_64__) || defined(__i386__)
+    static const bool bmi2 = __builtin_cpu_supports("bmi2");
+    if (bmi2) return selectInWordBmi2(w, r);
+#endif
+    for (; r > 0; r--) w &= w - 1;
+    return __builtin_ctzll(w);
+}
+
+class RankSelect {
+public:
+    // words must outlive the index and not change
+    RankSelect(const uint64_t* words, size_t nbits) : bits(words), nbits(nbits) {
+        size_t nwords = (nbits + 63) / 64;
+        size_t blocks = nwords / 8 + 1;   // + 1: rank(nbits) stays in range
+        counts.resize(2 * blocks);
+        uint64_t total = 0;
+        for (size_t b = 0; b < blocks; b++) {
+            counts[2 * b] = total;
+            uint64_t rel = 0, inBlock = 0;
+            for (size_t w = 0; w < 8; w++) {
+                if (w > 0) rel |= inBlock << (9 * (w - 1));
+                size_t i = 8 * b + w;
+                if (i < nwords) inBlock += __builtin_popcountll(word(i));
+            }
+            counts[2 * b + 1] = rel;
+            total += inBlock;
+        }
+        ones = total;
+
+        // blockOf[t] = block holding the (t * SUBSAMPLE)-th one
+        std::vector<uint32_t> blockOf;
+        size_t lastBlock = 0;   // block holding the last one
+        for (size_t b = 0, next = 0; b < blocks; b++) {
+            uint64_t end = b + 1 < blocks ? counts[2 * (b + 1)] : ones;
+            if (end > counts[2 * b]) lastBlock = b;
+            for (; next < end; next += SUBSAMPLE) blockOf.push_back((uint32_t)b);
+        }
+
+        // one stretch per SAMPLE ones: its first block .. the next one's
+        for (size_t j = 0; j * SAMPLE < ones; j++) {
+            size_t t = j * (SAMPLE / SUBSAMPLE), first = blockOf[t];
+            size_t last = t + SAMPLE / SUBSAMPLE < blockOf.size()
+                              ? blockOf[t + SAMPLE / SUBSAMPLE] : lastBlock;
+            Stretch st{(uint32_t)first, {}};
+            if (last - first >= LONG_SPAN) {
+                st.offsets[0] = SPARSE;
+                uint64_t at = positions.size();
+                memcpy(st.offsets + 1, &at, sizeof(at));
+                uint64_t seen = counts[2 * first];
+                uint64_t from = j * SAMPLE, to = std::min(ones, from + SAMPLE);
+                for (size_t i = 8 * first; seen < to; i++) {
+                    for (uint64_t w = word(i); w && seen < to; w &= w - 1, seen++)
+                        if (seen >= from) positions.push_back(i * 64 + __builtin_ctzll(w));
+                }
+            } else {
+                for (size_t m = 1; m <= SAMPLE / SUBSAMPLE; m++) {
+                    size_t b = t + m < blockOf.size() ? blockOf[t + m] : lastBlock;
+                    st.offsets[m] = (uint8_t)(b - first);
+                }
+            }
+            stretches.push_back(st);
+        }
+        stretches.shrink_to_fit();
+        positions.shrink_to_fit();
+    }
+
+    size_t size() const { return nbits; }
+    uint64_t count() const { return ones; }
+
+    // ones in [0, i), i <= size()
+    uint64_t rank(size_t i) const {
+        size_t w = i / 64, b = w / 8, k = w % 8;
+        uint64_t r = counts[2 * b] + relative(counts[2 * b + 1], k);
+        if (i % 64) r += __builtin_popcountll(bits[w] << (64 - i % 64));
+        return r;
+    }
+
+    // position of the k-th one, k < count()
+    size_t select(uint64_t k) const {
+        const Stretch& st = stretches[k / SAMPLE];
+        if (st.offsets[0] == SPARSE) {
+            uint64_t at;
+            memcpy(&at, st.offsets + 1, sizeof(at));
+            return positions[at + k % SAMPLE];
+        }
+        // the blocks holding the SUBSAMPLE ones around k
+        size_t m = k % SAMPLE / SUBSAMPLE;
+        size_t lo = st.first + st.offsets[m];
+        size_t hi = st.first + st.offsets[m + 1] + 1;
+        // last block in [lo, hi) whose absolute count is <= k
+        while (hi - lo > 1) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (counts[2 * mid] <= k) lo = mid;
+            else hi = mid;
+        }
+        uint64_t r = k - counts[2 * lo], rel = counts[2 * lo + 1];
+        size_t w = 0;
+        while (w < 7 && relative(rel, w + 1) <= r) w++;
+        r -= relative(rel, w);
+        return (8 * lo + w) * 64 + selectInWord(bits[8 * lo + w], (int)r);
+    }
+
+    size_t memoryBytes() const {
+        return counts.capacity() * sizeof(uint64_t) + stretches.capacity() * sizeof(Stretch) +
+               positions.capacity() * sizeof(uint64_t);
+    }
+
+private:
+    static const uint64_t SAMPLE = 512;
+    static const uint64_t SUBSAMPLE = 64;
+    static const size_t LONG_SPAN = 256;   // blocks; offsets fit a byte below it
+    static const uint8_t SPARSE = 0xff;   // offsets[0] of a dense stretch is 0
+
+    const uint64_t* bits;
+    size_t nbits;
+    uint64_t ones = 0;
+    std::vector<uint64_t> counts;    // per 512-bit block: absolute, packed relative
+    // one per SAMPLE ones, 16 bytes. Dense: offsets[m] = block of its
+    // (m * SUBSAMPLE)-th one - first, offsets[8] = the next stretch's
+    // first block (or the last block holding a one) - first.
+    // Sparse: offsets[0] = SPARSE, offsets[1..8] = where its SAMPLE
+    // positions start in `positions`
+    struct Stretch {
+        uint32_t first;
+        uint8_t offsets[SAMPLE / SUBSAMPLE + 1];
+    };
+    std::vector<Stretch> stretches;
+    std::vector<uint64_t> positions;
+
+    // word i with the bits past nbits cleared
+    uint64_t word(size_t i) const {
+        uint64_t w = bits[i];
+        if ((i + 1) * 64 > nbits) w &= (1ull << (nbits % 64)) - 1;
+        return w;
+    }
+
+    static uint64_t relative(uint64_t rel, size_t k) {
+        return k ? (rel >> (9 * (k - 1))) & 0x1ff : 0;
+    }
+};
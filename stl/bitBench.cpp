@@ -0,0 +1,101 @@
+#include <bits/stdc++.h>
+#include "../bench.h"
+#include "bitAnalytics.h"
+using namespace std;
+
+/*
+ Benchmark: bitAnalytics.h popcount kernels (GB/s of input read) and
+ rank / select (ns per query)
+
+ ./bitBench [queries]   (default 10000000)
+*/
+
+int main(int argc, char** argv) {
+    size_t queries = argc > 1 ? stoul(argv[1]) : 10000000;
+    mt19937_64 rng(23);
+    cout << fixed << setprecision(2);
+    cout << "dispatcher picks: " << kernelName(bestPopcountKernel()) << "\n";
+
+    const PopcountKernel kernels[] = {PopcountKernel::SCALAR, PopcountKernel::POPCNT,
+                                      PopcountKernel::AVX2, PopcountKernel::AVX512};
+    uint64_t sink = 0;
+    for (size_t bytes : {32u << 10, 1u << 20, 64u << 20}) {
+        size_t n = bytes / 8;
+        vector<uint64_t> a(n), b(n);
+        for (size_t i = 0; i < n; i++) a[i] = rng(), b[i] = rng();
+        size_t reps = max<size_t>(1, (256u << 20) / bytes);   // 256 MB per timing
+
+        cout << "== " << bytes / 1024 << " KB buffers, GB/s\n";
+        uint64_t expect = popcount(a.data(), n, PopcountKernel::SCALAR);
+        uint64_t expectAnd = popcountAnd(a.data(), b.data(), n, PopcountKernel::SCALAR);
+        for (PopcountKernel k : kernels) {
+            if (k == PopcountKernel::AVX512 && !__builtin_cpu_supports("avx512vpopcntdq")) continue;
+            if (k == PopcountKernel::AVX2 && !__builtin_cpu_supports("avx2")) continue;
+            uint64_t got = 0, gotAnd = 0;
+            double t = timeIt([&] {
+                for (size_t r = 0; r < reps; r++) {
+                    asm volatile("" ::: "memory");   // the buffer "changed": recount
+                    got = popcount(a.data(), n, k);
+                }
+            });
+            double tAnd = timeIt([&] {
+                for (size_t r = 0; r < reps; r++) {
+                    asm volatile("" ::: "memory");
+                    gotAnd = popcountAnd(a.data(), b.data(), n, k);
+                }
+            });
+            cout << "  " << left << setw(8) << kernelName(k) << right
+                 << " popcount " << setw(7) << reps * bytes / t / 1e9
+                 << "   popcount(a & b) " << setw(7) << 2 * reps * bytes / tAnd / 1e9
+                 << (got == expect && gotAnd == expectAnd ? "" : "  MISMATCH") << "\n";
+            sink += got + gotAnd;
+        }
+    }
+
+    // rank / select over 2^28 bits: half set, then sparse (1 in 4096 bits,
+    // every select stretch stores its positions), then mixed
+    size_t nbits = 1u << 28;
+    vector<uint64_t> bits(nbits / 64);
+    auto rankSelect = [&](const string& name) {
+        RankSelect rs(bits.data(), nbits);
+        cout << "== rank/select, " << nbits << " bits, " << name << ", index "
+             << rs.memoryBytes() * 100.0 / (nbits / 8) << "% of the data\n";
+
+        vector<uint64_t> pos(queries), ks(queries);
+        for (auto& p : pos) p = rng() % (nbits + 1);
+        for (auto& k : ks) k = rng() % rs.count();
+        double tr = timeIt([&] {
+            for (uint64_t p : pos) sink += rs.rank(p);
+        });
+        double ts = timeIt([&] {
+            for (uint64_t k : ks) sink += rs.select(k);
+        });
+        cout << "  rank   : " << tr * 1e9 / queries << " ns\n";
+        cout << "  select : " << ts * 1e9 / queries << " ns\n";
+
+        // select(rank(p)) lands on the first one at or after p,
+        // rank(select(k)) == k on a set bit
+        bool ok = true;
+        for (size_t i = 0; i < min<size_t>(queries, 100000); i++) {
+            uint64_t r = rs.rank(pos[i]);
+            if (r < rs.count()) {
+                size_t s = rs.select(r);
+                ok &= s >= pos[i] && rs.rank(s) == r && (bits[s / 64] >> (s % 64) & 1);
+            }
+            size_t s = rs.select(ks[i]);
+            ok &= rs.rank(s) == ks[i] && (bits[s / 64] >> (s % 64) & 1);
+        }
+        cout << (ok ? "" : "  MISMATCH\n");
+    };
+
+    for (auto& w : bits) w = rng();
+    rankSelect("half set");
+    for (auto& w : bits) w = rng() % 64 == 0 ? 1ull << (rng() % 64) : 0;
+    rankSelect("1 in 4096 set");
+    // dense and empty 1 MB regions in turn
+    for (size_t i = 0; i < bits.size(); i++) bits[i] = i >> 17 & 1 ? rng() : 0;
+    rankSelect("dense / empty runs");
+
+    keep(sink);
+    return 0;
+}
@@ -1,4 +1,6 @@
 #include <bits/stdc++.h>
+#include "flatContainers.h"
+#include "soaPairs.h"
 using namespace std;
 
 /*
@@ -36,6 +38,8 @@ int main() {
     pair<int, int> p = {1, 3};
     pair<int, pair<int, int>> nestedPair = {1, {2, 3}};
     pair<int, int> arr[] = {{1, 2}, {2, 3}};
+    SoAPairs<int, int> columns(begin(arr), end(arr));   // firsts and seconds in separate arrays
+    cout << "max first: " << columns.maxFirst() << "\n";
     
 
     // Uncomment to test
@@ -332,6 +336,12 @@ void explainSet() {
     if (ub != s.end()) {
         cout << "upper_bound(9): " << *ub << endl;
     }
+
+    // same calls on one sorted array, no node per element
+    // (flatContainers.h, see flatBench.cpp)
+    FlatSet<int> fs(s.begin(), s.end());
+    fs.setLayout(FlatLayout::EYTZINGER);   // read-heavy: cache-friendly search order
+    cout << "flat lower_bound(5): " << *fs.lower_bound(5) << endl;
 }
 
 
@@ -390,6 +400,11 @@ void explainMultiSet() {
         //so if it doesn't exist then it has to do that 
         ms.erase(it2, next(it2));
     }
+
+    // flat version: built in one sort, same count / find / erase
+    FlatMultiSet<int> fms = {1, 1, 3, 4};
+    fms.erase(fms.find(1));
+    cout << "Flat count of 1: " << fms.count(1) << endl;
 }
 
 /*
@@ -507,6 +522,11 @@ void explainMap() {
     auto it1 = map1.lower_bound(2); // first key >= 2
     auto it2 = map1.upper_bound(2); // first key > 2
 
+    // flat version: pairs in one sorted array, same calls
+    FlatMap<int, int> flat(map1.begin(), map1.end());
+    flat[4] = 8;
+    cout << flat.lower_bound(2)->second << endl;
+
     // traversal (sorted order)
     // for (auto it : map1) {
     //     cout << it.first << " " << it.second << endl;
@@ -594,6 +614,11 @@ void explainMultiMap() {
         cout << it->second << " ";
     }
     cout << endl;
+
+    // flat version keeps equal keys in insertion order too
+    FlatMultiMap<int, int> fmm(mm.begin(), mm.end());
+    auto flatRange = fmm.equal_range(1);
+    cout << flatRange.second - flatRange.first << endl;
 }
 
 /*
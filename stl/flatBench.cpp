@@ -0,0 +1,86 @@
+#include <bits/stdc++.h>
+#include "../bench.h"
+#include "flatContainers.h"
+using namespace std;
+
+/*
+ Benchmark: set / map (one tree node per element) vs FlatSet / FlatMap
+ (flatContainers.h), sorted and Eytzinger search: build, find,
+ lower_bound and a full scan
+
+ ./flatBench [maxN] [queries]   (default 10000000, 5000000)
+*/
+
+int keyOf(int k) { return k; }
+template <class P>
+int keyOf(const P& p) { return p.first; }
+
+// one row: ns per build element, per find, per lower_bound, per scanned element
+template <class C, class Build>
+void row(const string& name, Build build, const vector<int>& queries, uint64_t& sink) {
+    C c;
+    double tb = timeIt([&] { c = build(); });
+    uint64_t found = 0, bounds = 0, sum = 0;
+    double tf = timeIt([&] {
+        for (int q : queries) found += c.find(q) != c.end();
+    });
+    double tl = timeIt([&] {
+        for (int q : queries) {
+            auto it = c.lower_bound(q);
+            if (it != c.end()) bounds += keyOf(*it);
+        }
+    });
+    double ts = timeIt([&] {
+        for (auto& x : c) sum += keyOf(x);
+    });
+    cout << "  " << left << setw(18) << name << right
+         << setw(8) << tb * 1e9 / c.size() << setw(10) << tf * 1e9 / queries.size()
+         << setw(13) << tl * 1e9 / queries.size() << setw(8) << ts * 1e9 / c.size()
+         << "   (" << found << " hits)\n";
+    sink += found + bounds + sum;
+}
+
+int main(int argc, char** argv) {
+    size_t maxN = argc > 1 ? stoul(argv[1]) : 10000000;
+    size_t nq = argc > 2 ? stoul(argv[2]) : 5000000;
+    mt19937 rng(25);
+    cout << fixed << setprecision(2);
+    uint64_t sink = 0;
+
+    for (size_t n = 1000; n <= maxN; n *= 10) {
+        // keys are random even numbers, queries hit about half the time
+        vector<int> keys(n);
+        for (auto& k : keys) k = (int)(rng() % (4 * n)) & ~1;
+        vector<int> queries(nq);
+        for (auto& q : queries) q = (int)(rng() % (4 * n));
+        vector<pair<int, int>> rows(n);
+        for (size_t i = 0; i < n; i++) rows[i] = {keys[i], (int)i};
+
+        cout << "== " << n << " keys, ns per: build     find  lower_bound    scan\n";
+        row<set<int>>("set", [&] {
+            set<int> s;
+            for (int k : keys) s.insert(k);
+            return s;
+        }, queries, sink);
+        row<FlatSet<int>>("FlatSet", [&] { return FlatSet<int>(keys); }, queries, sink);
+        row<FlatSet<int>>("FlatSet eytzinger", [&] {
+            FlatSet<int> s(keys);
+            s.setLayout(FlatLayout::EYTZINGER);
+            return s;
+        }, queries, sink);
+        row<map<int, int>>("map", [&] {
+            map<int, int> m;
+            for (auto& r : rows) m.insert(r);
+            return m;
+        }, queries, sink);
+        row<FlatMap<int, int>>("FlatMap", [&] { return FlatMap<int, int>(rows); }, queries, sink);
+        row<FlatMap<int, int>>("FlatMap eytzinger", [&] {
+            FlatMap<int, int> m(rows);
+            m.setLayout(FlatLayout::EYTZINGER);
+            return m;
+        }, queries, sink);
+    }
+
+    keep(sink);
+    return 0;
+}
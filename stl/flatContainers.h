@@ -0,0 +1,348 @@
+#pragma once
+#include <bits/stdc++.h>
+
+#include "soaPairs.h"   // AlignedAllocator
+
+/*
+========================================
+ FLAT (SORTED ARRAY) SETS AND MAPS
+----------------------------------------
+ FlatSet<T>, FlatMultiSet<T>, FlatMap<K, V>, FlatMultiMap<K, V>
+   same find / count / contains / lower_bound / upper_bound /
+   equal_range / insert / emplace / erase calls as set, multiset, map
+   and multimap, over one sorted vector instead of one tree node per
+   element. Iteration is a linear scan and iterators are random access.
+
+   built in bulk     (first, last), (vector), {a, b, c} or
+                     insert(first, last): append, stable sort, merge,
+                     drop repeated keys (sets / maps keep the first one,
+                     multi containers keep insertion order) - O(n log n)
+   single insert     O(n): shifts the tail, like vector::insert
+   erase             O(n), iterators after the erased element move
+
+   Read-heavy tables: build once, then look up.
+
+ setLayout(FlatLayout::EYTZINGER)
+   also keeps the keys in Eytzinger (BFS) order: node k has children
+   2k and 2k + 1, so the first levels of every search share a few cache
+   lines and the next levels are prefetched (one 64-byte line holds 16
+   int descendants four levels down). Lookups walk that array and map
+   back to the sorted position; iteration still uses the sorted vector.
+   Costs one key + 4 bytes per element, rebuilt (O(n)) after every
+   change. Keys must be default constructible.
+
+ Map values are pair<K, V>, not pair<const K, V>: it->second can be
+ written, it->first must not be changed.
+========================================
+*/
+
+enum class FlatLayout { SORTED, EYTZINGER };
+
+template <class T>
+struct FlatIdentity {
+    const T& operator()(const T& v) const { return v; }
+};
+
+template <class K, class V>
+struct FlatFirst {
+    const K& operator()(const std::pair<K, V>& p) const { return p.first; }
+};
+
+template <class Key, class Value, class KeyOf, class Compare, bool Multi>
+class FlatTree {
+    using Storage = std::vector<Value>;
+
+public:
+    using key_type = Key;
+    using value_type = Value;
+    using key_compare = Compare;
+    using size_type = size_t;
+    using const_iterator = typename Storage::const_iterator;
+    // set elements are their own keys: read-only, like set::iterator
+    using iterator = std::conditional_t<std::is_same_v<Key, Value>, const_iterator,
+                                        typename Storage::iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    FlatTree() = default;
+    explicit FlatTree(const Compare& comp) : comp(comp) {}
+    explicit FlatTree(Storage values, const Compare& comp = Compare())
+        : items(std::move(values)), comp(comp) {
+        normalize(0);
+    }
+    template <class It>
+    FlatTree(It first, It last, const Compare& comp = Compare())
+        : FlatTree(Storage(first, last), comp) {}
+    FlatTree(std::initializer_list<Value> values, const Compare& comp = Compare())
+        : FlatTree(Storage(values), comp) {}
+
+    /* ---------- Layout ---------- */
+
+    void setLayout(FlatLayout l) {
+        searchLayout = l;
+        reindex();
+    }
+    FlatLayout layout() const { return searchLayout; }
+
+    // sorted elements + search index
+    size_t memoryBytes() const {
+        return items.capacity() * sizeof(Value) + eyKeys.capacity() * sizeof(Key) +
+               eyRank.capacity() * sizeof(uint32_t);
+    }
+
+    /* ---------- Iteration ---------- */
+
+    iterator begin() { return items.begin(); }
+    iterator end() { return items.end(); }
+    const_iterator begin() const { return items.begin(); }
+    const_iterator end() const { return items.end(); }
+    const_iterator cbegin() const { return items.begin(); }
+    const_iterator cend() const { return items.end(); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+    // the sorted elements as one array
+    const Value* data() const { return items.data(); }
+
+    void reserve(size_t n) { items.reserve(n); }
+    void shrink_to_fit() {
+        items.shrink_to_fit();
+        reindex();
+    }
+    void clear() {
+        items.clear();
+        reindex();
+    }
+    void swap(FlatTree& o) {
+        std::swap(items, o.items);
+        std::swap(eyKeys, o.eyKeys);
+        std::swap(eyRank, o.eyRank);
+        std::swap(comp, o.comp);
+        std::swap(searchLayout, o.searchLayout);
+    }
+
+    /* ---------- Lookup ---------- */
+
+    iterator find(const Key& k) { return begin() + findIndex(k); }
+    const_iterator find(const Key& k) const { return begin() + findIndex(k); }
+    bool contains(const Key& k) const { return findIndex(k) != size(); }
+    size_t count(const Key& k) const {
+        if constexpr (Multi) return upperIndex(k) - lowerIndex(k);
+        else return contains(k);
+    }
+
+    iterator lower_bound(const Key& k) { return begin() + lowerIndex(k); }
+    const_iterator lower_bound(const Key& k) const { return begin() + lowerIndex(k); }
+    iterator upper_bound(const Key& k) { return begin() + upperIndex(k); }
+    const_iterator upper_bound(const Key& k) const { return begin() + upperIndex(k); }
+    std::pair<iterator, iterator> equal_range(const Key& k) {
+        auto [lo, hi] = rangeIndex(k);
+        return {begin() + lo, begin() + hi};
+    }
+    std::pair<const_iterator, const_iterator> equal_range(const Key& k) const {
+        auto [lo, hi] = rangeIndex(k);
+        return {begin() + lo, begin() + hi};
+    }
+
+    key_compare key_comp() const { return comp; }
+
+    /* ---------- Insert / erase ---------- */
+
+    // set / map: pair<iterator, bool>; multi: iterator (after equal keys)
+    auto insert(const Value& v) { return insertValue(v); }
+    auto insert(Value&& v) { return insertValue(std::move(v)); }
+    template <class... A>
+    auto emplace(A&&... args) {
+        return insertValue(Value(std::forward<A>(args)...));
+    }
+
+    template <class It>
+    void insert(It first, It last) {
+        size_t from = items.size();
+        items.insert(items.end(), first, last);
+        normalize(from);
+    }
+    void insert(std::initializer_list<Value> values) { insert(values.begin(), values.end()); }
+
+    iterator erase(const_iterator pos) {
+        size_t i = pos - items.cbegin();
+        items.erase(pos);
+        reindex();
+        return begin() + i;
+    }
+    iterator erase(const_iterator first, const_iterator last) {
+        size_t i = first - items.cbegin();
+        items.erase(first, last);
+        reindex();
+        return begin() + i;
+    }
+    // every element with key k (multi: all of them), returns how many
+    size_t erase(const Key& k) {
+        auto [lo, hi] = rangeIndex(k);
+        if (lo == hi) return 0;
+        items.erase(items.begin() + lo, items.begin() + hi);
+        reindex();
+        return hi - lo;
+    }
+
+protected:
+    Storage items;
+    Compare comp;
+    FlatLayout searchLayout = FlatLayout::SORTED;
+    // Eytzinger copy of the keys (1-based) and each key's sorted position
+    std::vector<Key, AlignedAllocator<Key>> eyKeys;
+    std::vector<uint32_t> eyRank;
+
+    static const Key& key(const Value& v) { return KeyOf()(v); }
+
+    size_t lowerIndex(const Key& k) const {
+        if (!eyRank.empty()) return rankOf(lowerNode(k));
+        return std::lower_bound(items.begin(), items.end(), k,
+                                [&](const Value& v, const Key& x) { return comp(key(v), x); }) -
+               items.begin();
+    }
+    size_t upperIndex(const Key& k) const {
+        if (!eyRank.empty()) return rankOf(eytzinger([&](const Key& x) { return !comp(k, x); }));
+        return std::upper_bound(items.begin(), items.end(), k,
+                                [&](const Key& x, const Value& v) { return comp(x, key(v)); }) -
+               items.begin();
+    }
+    std::pair<size_t, size_t> rangeIndex(const Key& k) const {
+        if constexpr (Multi) {
+            return {lowerIndex(k), upperIndex(k)};
+        } else {
+            size_t i = findIndex(k);
+            if (i != size()) return {i, i + 1};
+            size_t lo = lowerIndex(k);
+            return {lo, lo};
+        }
+    }
+    size_t findIndex(const Key& k) const {
+        if (!eyRank.empty()) {
+            // the last node compared is still in cache, items[i] may not be
+            size_t node = lowerNode(k);
+            return node && !comp(k, eyKeys[node]) ? eyRank[node] : size();
+        }
+        size_t i = lowerIndex(k);
+        return i < size() && !comp(k, key(items[i])) ? i : size();
+    }
+
+    size_t lowerNode(const Key& k) const {
+        return eytzinger([&](const Key& x) { return comp(x, k); });
+    }
+    size_t rankOf(size_t node) const { return node ? eyRank[node] : size(); }
+
+    /*
+     Node of the first key (in sorted order) that does not goRight, 0 if
+     none. Walks down from the root (go right while goRight(key)); the
+     answer is the last node where the walk went left: strip the
+     trailing right turns (ones) and that left turn (a zero) off k.
+    */
+    template <class GoRight>
+    size_t eytzinger(GoRight goRight) const {
+        constexpr size_t AHEAD = std::max<size_t>(1, 64 / sizeof(Key));
+        const Key* b = eyKeys.data();
+        size_t n = items.size(), k = 1;
+        while (k <= n) {
+            __builtin_prefetch(b + std::min(k * AHEAD, n));
+            k = 2 * k + goRight(b[k]);
+        }
+        return k >> __builtin_ffsll((long long)~k);
+    }
+
+    void reindex() {
+        eyKeys.clear();
+        eyRank.clear();
+        if (searchLayout != FlatLayout::EYTZINGER || items.empty()) return;
+        if (items.size() >= UINT32_MAX) throw std::length_error("flat container too large for EYTZINGER");
+        eyKeys.resize(items.size() + 1);
+        eyRank.resize(items.size() + 1);
+        size_t next = 0;
+        fillEytzinger(1, next);
+    }
+    // in-order walk of the implicit tree hands out sorted positions
+    void fillEytzinger(size_t k, size_t& next) {
+        if (k > items.size()) return;
+        fillEytzinger(2 * k, next);
+        eyKeys[k] = key(items[next]);
+        eyRank[k] = (uint32_t)next++;
+        fillEytzinger(2 * k + 1, next);
+    }
+
+    // items[0, from) is sorted (and unique): sort the rest and merge it in
+    void normalize(size_t from) {
+        auto less = [&](const Value& a, const Value& b) { return comp(key(a), key(b)); };
+        std::stable_sort(items.begin() + from, items.end(), less);
+        std::inplace_merge(items.begin(), items.begin() + from, items.end(), less);
+        if constexpr (!Multi) {
+            auto same = [&](const Value& a, const Value& b) { return !less(a, b); };
+            items.erase(std::unique(items.begin(), items.end(), same), items.end());
+        }
+        reindex();
+    }
+
+    template <class V>
+    auto insertValue(V&& v) {
+        if constexpr (Multi) {
+            size_t i = upperIndex(key(v));
+            items.insert(items.begin() + i, std::forward<V>(v));
+            reindex();
+            return begin() + i;
+        } else {
+            size_t i = lowerIndex(key(v));
+            if (i < size() && !comp(key(v), key(items[i]))) return std::make_pair(begin() + i, false);
+            items.insert(items.begin() + i, std::forward<V>(v));
+            reindex();
+            return std::make_pair(begin() + i, true);
+        }
+    }
+};
+
+template <class T, class Compare = std::less<T>>
+using FlatSet = FlatTree<T, T, FlatIdentity<T>, Compare, false>;
+
+template <class T, class Compare = std::less<T>>
+using FlatMultiSet = FlatTree<T, T, FlatIdentity<T>, Compare, true>;
+
+template <class K, class V, class Compare = std::less<K>>
+using FlatMultiMap = FlatTree<K, std::pair<K, V>, FlatFirst<K, V>, Compare, true>;
+
+template <class K, class V, class Compare = std::less<K>>
+class FlatMap : public FlatTree<K, std::pair<K, V>, FlatFirst<K, V>, Compare, false> {
+    using Base = FlatTree<K, std::pair<K, V>, FlatFirst<K, V>, Compare, false>;
+
+public:
+    using mapped_type = V;
+    using typename Base::iterator;
+    using Base::Base;
+
+    // inserts V{} when k is missing
+    V& operator[](const K& k) { return try_emplace(k).first->second; }
+
+    V& at(const K& k) {
+        auto it = this->find(k);
+        if (it == this->end()) throw std::out_of_range("FlatMap::at");
+        return it->second;
+    }
+    const V& at(const K& k) const {
+        auto it = this->find(k);
+        if (it == this->end()) throw std::out_of_range("FlatMap::at");
+        return it->second;
+    }
+
+    // builds the value only when k is missing
+    template <class... A>
+    std::pair<iterator, bool> try_emplace(const K& k, A&&... args) {
+        size_t i = this->lowerIndex(k);
+        if (i < this->size() && !this->comp(k, this->items[i].first))
+            return {this->begin() + i, false};
+        this->items.emplace(this->items.begin() + i, std::piecewise_construct,
+                            std::forward_as_tuple(k), std::forward_as_tuple(std::forward<A>(args)...));
+        this->reindex();
+        return {this->begin() + i, true};
+    }
+};
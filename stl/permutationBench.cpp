@@ -0,0 +1,85 @@
+#include <bits/stdc++.h>
+#include "../bench.h"
+#include "permutations.h"
+using namespace std;
+
+/*
+ Benchmark: walking a permutation space with next_permutation (the
+ Algorithms.cpp loop) vs PermutationSpace ranges, 1..N threads
+
+ ./permutationBench [n] [maxThreads]   (default 12, all cores)
+*/
+
+// cheap per-ordering work; summed over the space it does not depend
+// on visiting order
+inline uint64_t weigh(const int* p, size_t n) {
+    return (uint64_t)p[0] * 131 + (uint64_t)p[n / 2] * 7 + p[n - 1];
+}
+
+struct alignas(64) Sum {
+    uint64_t v = 0;
+};
+
+void space(const string& name, vector<int> items, int maxThreads) {
+    PermutationSpace<int> sp(items);
+    size_t n = items.size();
+    cout << "== " << name << ": " << sp.size() << " orderings, ns per ordering\n";
+
+    uint64_t expect = 0;
+    double t = timeIt([&] {
+        sort(items.begin(), items.end());
+        do expect += weigh(items.data(), n);
+        while (next_permutation(items.begin(), items.end()));
+    });
+    cout << "  next_permutation loop     : " << t * 1e9 / sp.size() << "\n";
+
+    for (auto order : {PermutationOrder::LEXICOGRAPHIC, PermutationOrder::FAST}) {
+        if (order == PermutationOrder::FAST && !sp.distinct()) continue;
+        const char* label = order == PermutationOrder::FAST ? "heap" : "lex ";
+        for (int th = 1; th <= maxThreads; th = th < maxThreads ? min(2 * th, maxThreads) : th + 1) {
+            vector<Sum> sums(th);
+            double tp = timeIt([&] {
+                sp.forEachParallel(th, [&](int t, const int* p) { sums[t].v += weigh(p, n); }, order);
+            });
+            uint64_t got = 0;
+            for (auto& x : sums) got += x.v;
+            cout << "  " << label << " ranges, " << setw(3) << th << " thread(s): "
+                 << tp * 1e9 / sp.size() << (got == expect ? "" : "  MISMATCH") << "\n";
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? stoi(argv[1]) : 12;
+    int maxThreads = argc > 2 ? stoi(argv[2]) : max(1u, thread::hardware_concurrency());
+    cout << fixed << setprecision(2);
+
+    vector<int> distinctItems(n);
+    iota(distinctItems.begin(), distinctItems.end(), 1);
+    space("distinct", distinctItems, maxThreads);
+
+    // every value twice (n + 2 items, so the space is still big)
+    vector<int> pairs;
+    for (int i = 0; i < (n + 2) / 2; i++) pairs.push_back(i), pairs.push_back(i);
+    space("multiset", pairs, maxThreads);
+
+    // printing 9! orderings of "123456789"
+    FILE* null = fopen("/dev/null", "w");
+    string s = "123456789";
+    ofstream nullStream("/dev/null");
+    double tc = timeIt([&] {
+        do nullStream << s << "\n";
+        while (next_permutation(s.begin(), s.end()));
+        nullStream.flush();
+    });
+    PermutationSpace<char> chars(vector<char>(s.begin(), s.end()));
+    double tsink = timeIt([&] {
+        PermutationSink sink(null);
+        chars.forEach(0, chars.size(), [&](const char* p) { sink.put(p, 9); });
+    });
+    cout << "== printing " << chars.size() << " orderings, ns per line\n"
+         << "  ofstream <<              : " << tc * 1e9 / chars.size() << "\n"
+         << "  PermutationSink          : " << tsink * 1e9 / chars.size() << "\n";
+    fclose(null);
+    return 0;
+}
@@ -0,0 +1,244 @@
+#pragma once
+#include <bits/stdc++.h>
+
+/*
+========================================
+ PERMUTATION SPACES
+----------------------------------------
+ PermutationSpace<T>(items)
+   all orderings of items (sorted on construction), ranked
+   lexicographically: rank 0 is sorted, size() - 1 reversed. With
+   duplicates only distinct orderings count, so size() is
+   n! / (c1! c2! ...).
+   n <= 20, so every rank fits in 64 bits.
+
+   unrank(k, out)      k-th ordering, factorial number system (digit i
+                       picks among the n - i items left); for
+                       multisets each candidate's block is the number
+                       of orderings of what remains
+   forEach(lo, hi, f)  every ordering with rank in [lo, hi), f(perm)
+   forEachParallel(threads, f)
+                       the whole space as disjoint rank ranges taken
+                       by threads from a shared counter, f(t, perm)
+
+   PermutationOrder::LEXICOGRAPHIC  visits in rank order
+                                    (next_permutation steps)
+   PermutationOrder::FAST           same set, any order: a range
+                                    aligned to m! fixes the first
+                                    n - m items and runs Heap's
+                                    algorithm (one swap per step) on
+                                    the rest. Multisets always step
+                                    lexicographically (Heap's would
+                                    repeat orderings).
+
+ PermutationSink(out)
+   per-thread text buffer: one ordering per line (chars as is, other
+   values space-separated), handed to fwrite 64 KB at a time. A block
+   is one fwrite, so lines from different threads never mix, but
+   blocks from different threads interleave in any order.
+========================================
+*/
+
+enum class PermutationOrder { LEXICOGRAPHIC, FAST };
+
+template <class T>
+class PermutationSpace {
+public:
+    static constexpr int MAX_ITEMS = 20;
+
+    explicit PermutationSpace(std::vector<T> items) : items(std::move(items)) {
+        if (this->items.size() > MAX_ITEMS) throw std::length_error("more than 20 items");
+        std::sort(this->items.begin(), this->items.end());
+        for (size_t i = 0; i < this->items.size(); i++) {
+            if (i == 0 || this->items[i] != this->items[i - 1]) {
+                values.push_back(this->items[i]);
+                counts.push_back(0);
+            }
+            counts.back()++;
+        }
+        total = arrangements(counts);
+    }
+
+    size_t length() const { return items.size(); }
+    uint64_t size() const { return total; }
+    bool distinct() const { return values.size() == items.size(); }
+
+    // out holds length() items
+    void unrank(uint64_t k, T* out) const {
+        size_t n = items.size();
+        if (distinct()) {
+            // digit i of k in base (n - i)!: which of the remaining items
+            T left[MAX_ITEMS];
+            std::copy(items.begin(), items.end(), left);
+            for (size_t i = 0; i < n; i++) {
+                uint64_t f = factorial((int)(n - 1 - i));
+                size_t d = k / f;
+                k %= f;
+                out[i] = left[d];
+                std::copy(left + d + 1, left + n - i, left + d);
+            }
+            return;
+        }
+        std::vector<int> left = counts;
+        for (size_t i = 0; i < n; i++) {
+            for (size_t v = 0; v < values.size(); v++) {
+                if (!left[v]) continue;
+                left[v]--;
+                uint64_t block = arrangements(left);
+                if (k < block) {
+                    out[i] = values[v];
+                    break;
+                }
+                k -= block;
+                left[v]++;
+            }
+        }
+    }
+
+    // f(const T* perm) for ranks in [lo, hi)
+    template <class F>
+    void forEach(uint64_t lo, uint64_t hi, F f,
+                 PermutationOrder order = PermutationOrder::LEXICOGRAPHIC) const {
+        hi = std::min(hi, total);
+        if (lo >= hi) return;
+        size_t n = items.size();
+        std::vector<T> cur(std::max<size_t>(n, 1));
+        unrank(lo, cur.data());
+
+        if (order == PermutationOrder::FAST && distinct()) {
+            while (lo < hi) {
+                // largest m with lo on an m! boundary and the whole block in range
+                size_t m = 1;
+                while (m < n && lo % factorial((int)m + 1) == 0 && lo + factorial((int)m + 1) <= hi) m++;
+                if (m == 1) {
+                    f((const T*)cur.data());
+                    lo++;
+                    if (lo < hi) std::next_permutation(cur.begin(), cur.end());
+                    continue;
+                }
+                heap(cur.data() + (n - m), m, [&] { f((const T*)cur.data()); });
+                lo += factorial((int)m);
+                if (lo < hi) unrank(lo, cur.data());
+            }
+            return;
+        }
+        for (;; std::next_permutation(cur.begin(), cur.end())) {
+            f((const T*)cur.data());
+            if (++lo == hi) break;
+        }
+    }
+
+    /*
+     f(thread, const T* perm) for every ordering. Ranges are m!
+     orderings, m chosen so there are at least 64 per thread.
+    */
+    template <class F>
+    void forEachParallel(int threads, F f,
+                         PermutationOrder order = PermutationOrder::FAST) const {
+        threads = std::max(1, threads);
+        uint64_t chunk = 1;
+        for (int m = 1; m <= (int)items.size() && total / factorial(m) >= 64u * threads; m++)
+            chunk = factorial(m);
+        uint64_t chunks = (total + chunk - 1) / chunk;
+        std::atomic<uint64_t> next{0};
+        auto work = [&](int t) {
+            for (uint64_t c; (c = next++) < chunks;)
+                forEach(c * chunk, (c + 1) * chunk, [&](const T* p) { f(t, p); }, order);
+        };
+        std::vector<std::thread> pool;
+        for (int t = 1; t < threads; t++) pool.emplace_back(work, t);
+        work(0);
+        for (auto& th : pool) th.join();
+    }
+
+    static uint64_t factorial(int n) {
+        static const auto table = [] {
+            std::array<uint64_t, MAX_ITEMS + 1> f{};
+            f[0] = 1;
+            for (int i = 1; i <= MAX_ITEMS; i++) f[i] = f[i - 1] * i;
+            return f;
+        }();
+        return table[n];
+    }
+
+private:
+    std::vector<T> items;
+    std::vector<T> values;   // distinct items, ascending
+    std::vector<int> counts;
+    uint64_t total;
+
+    // n! / (c1! c2! ...), built as a product of binomials so it never
+    // overflows before the result does
+    static uint64_t arrangements(const std::vector<int>& c) {
+        uint64_t r = 1;
+        int placed = 0;
+        for (int k : c) {
+            for (int j = 1; j <= k; j++)   // r *= C(placed + k, k)
+                r = (uint64_t)((unsigned __int128)r * (placed + j) / j);
+            placed += k;
+        }
+        return r;
+    }
+
+    // every ordering of a[0, m), visit() after each; a ends permuted
+    template <class V>
+    static void heap(T* a, size_t m, V visit) {
+        int c[MAX_ITEMS] = {};
+        visit();
+        for (size_t i = 1; i < m;) {
+            if ((size_t)c[i] < i) {
+                std::swap(a[i % 2 ? c[i] : 0], a[i]);
+                visit();
+                c[i]++;
+                i = 1;
+            } else {
+                c[i] = 0;
+                i++;
+            }
+        }
+    }
+};
+
+class PermutationSink {
+public:
+    explicit PermutationSink(FILE* out = stdout, size_t capacity = 1 << 16)
+        : out(out), capacity(capacity) {
+        buf.reserve(capacity + 256);
+    }
+    ~PermutationSink() { flush(); }
+
+    PermutationSink(const PermutationSink&) = delete;
+    PermutationSink& operator=(const PermutationSink&) = delete;
+
+    template <class T>
+    void put(const T* p, size_t n) {
+        if constexpr (std::is_same_v<T, char>) {
+            buf.append(p, n);
+        } else {
+            for (size_t i = 0; i < n; i++) {
+                if (i) buf += ' ';
+                if constexpr (std::is_integral_v<T>) {
+                    char tmp[24];
+                    auto r = std::to_chars(tmp, tmp + sizeof tmp, p[i]);
+                    buf.append(tmp, r.ptr);
+                } else {
+                    std::ostringstream s;
+                    s << p[i];
+                    buf += s.str();
+                }
+            }
+        }
+        buf += '\n';
+        if (buf.size() >= capacity) flush();
+    }
+
+    void flush() {
+        if (!buf.empty()) fwrite(buf.data(), 1, buf.size(), out);
+        buf.clear();
+    }
+
+private:
+    FILE* out;
+    size_t capacity;
+    std::string buf;
+};
@@ -0,0 +1,87 @@
+#include <bits/stdc++.h>
+#include "../bench.h"
+#include "soaPairs.h"
+using namespace std;
+
+/*
+ Benchmark: SoAPairs<int, int> vs vector<pair<int, int>> (AoS) for
+ one-field scans and sorts
+
+ ./soaBench [n]   (default 10000000 rows)
+*/
+
+bool comp(const pair<int,int>& p1,
+          const pair<int,int>& p2) {
+    if (p1.second != p2.second)
+        return p1.second < p2.second;
+    return p1.first > p2.first;
+}
+
+bool same(SoAPairs<int,int>& s, const vector<pair<int,int>>& v) {
+    for (size_t i = 0; i < v.size(); i++)
+        if (pair<int,int>(s[i]) != v[i]) return false;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? stoul(argv[1]) : 10000000;
+    mt19937 rng(22);
+    vector<pair<int,int>> aos(n);
+    for (auto& p : aos) p = {(int)rng(), (int)(rng() % 1000000)};
+    SoAPairs<int,int> soa(aos.begin(), aos.end());
+
+    cout << fixed << setprecision(2) << n << " rows\n";
+
+    int m1 = 0, m2 = 0, m3 = 0;
+    cout << "max of first (ms)\n";
+    cout << "  AoS max_element       : " << msFor([&] {
+        m1 = max_element(aos.begin(), aos.end(), [](auto& x, auto& y) {
+            return x.first < y.first;
+        })->first;
+    }) << "\n";
+    cout << "  SoA max_element       : " << msFor([&] {
+        m2 = *max_element(soa.firsts(), soa.firsts() + n);
+    }) << "\n";
+    cout << "  SoA maxFirst          : " << msFor([&] { m3 = soa.maxFirst(); })
+         << (m1 == m2 && m2 == m3 ? "" : "  MISMATCH") << "\n";
+
+    // key-only: order by second, ties in input order
+    cout << "sort by second only (ms)\n";
+    vector<pair<int,int>> bySecond = aos;
+    cout << "  AoS stable_sort       : " << msFor([&] {
+        stable_sort(bySecond.begin(), bySecond.end(), [](auto& x, auto& y) {
+            return x.second < y.second;
+        });
+    }) << "\n";
+    SoAPairs<int,int> s1 = soa;
+    cout << "  SoA sortBySecond      : " << msFor([&] { s1.sortBySecond(); })
+         << (same(s1, bySecond) ? "" : "  MISMATCH") << "\n";
+
+    cout << "sort with comp (ms)\n";
+    vector<pair<int,int>> byComp = aos;
+    cout << "  AoS std::sort         : " << msFor([&] {
+        sort(byComp.begin(), byComp.end(), comp);
+    }) << "\n";
+    vector<pair<int,int>> radix = aos;
+    cout << "  AoS radixSortPairs    : " << msFor([&] {
+        radixSortPairs(radix.data(), n);
+    }) << (radix == byComp ? "" : "  MISMATCH") << "\n";
+    SoAPairs<int,int> s2 = soa;
+    cout << "  SoA sortBy(comp)      : " << msFor([&] { s2.sortBy(comp); })
+         << (same(s2, byComp) ? "" : "  MISMATCH") << "\n";
+    SoAPairs<int,int> s3 = soa;
+    cout << "  SoA std::sort proxies : " << msFor([&] {
+        sort(s3.begin(), s3.end(), comp);
+    }) << (same(s3, byComp) ? "" : "  MISMATCH") << "\n";
+
+    long long total = 0;
+    cout << "sum of second (ms)\n";
+    cout << "  AoS                   : " << msFor([&] {
+        for (auto& p : aos) total += p.second;
+    }) << "\n";
+    cout << "  SoA                   : " << msFor([&] {
+        const int* s = soa.seconds();
+        for (size_t i = 0; i < n; i++) total -= s[i];
+    }) << (total == 0 ? "" : "  MISMATCH") << "\n";
+    return 0;
+}
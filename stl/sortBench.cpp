@@ -0,0 +1,73 @@
+#include <bits/stdc++.h>
+#include "../bench.h"
+#include "sorting.h"
+using namespace std;
+
+/*
+ Benchmark: sorting.h engines vs std::sort with Algorithms.cpp's
+ comparators (greater<int> on ints, comp on pairs), over
+ random / sorted / reversed / many-duplicates inputs
+
+ ./sortBench [n] [threads]   (default 10000000, all cores)
+*/
+
+bool comp(const pair<int,int>& p1,
+          const pair<int,int>& p2) {
+    if (p1.second != p2.second)
+        return p1.second < p2.second;
+    return p1.first > p2.first;
+}
+
+template <class T, class F>
+void row(const string& name, const vector<T>& input, const vector<T>& expect, F sortFn) {
+    vector<T> v = input;
+    double ms = msFor([&] { sortFn(v); });
+    cout << "    " << left << setw(22) << name << right << setw(9) << ms << " ms"
+         << (v == expect ? "" : "  MISMATCH") << "\n";
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? stoul(argv[1]) : 10000000;
+    int threads = argc > 2 ? stoi(argv[2]) : max(1u, thread::hardware_concurrency());
+    mt19937 rng(21);
+    cout << fixed << setprecision(1);
+    cout << n << " elements, " << threads << " thread(s)\n";
+
+    for (string dist : {"random", "sorted", "reversed", "many duplicates"}) {
+        auto draw = [&] { return dist == "many duplicates" ? (int)(rng() % 100) : (int)rng(); };
+
+        vector<int> ints(n);
+        for (auto& x : ints) x = draw();
+        vector<pair<int,int>> pairs(n);
+        for (auto& p : pairs) p = {draw(), draw()};
+        // "sorted" means already in the target order
+        if (dist == "sorted") {
+            sort(ints.begin(), ints.end(), greater<int>());
+            sort(pairs.begin(), pairs.end(), comp);
+        } else if (dist == "reversed") {
+            sort(ints.begin(), ints.end());
+            sort(pairs.begin(), pairs.end(), comp);
+            reverse(pairs.begin(), pairs.end());
+        }
+
+        cout << "== " << dist << "\n  int, greater<int>\n";
+        vector<int> ie = ints;
+        sort(ie.begin(), ie.end(), greater<int>());
+        row("std::sort", ints, ie, [](vector<int>& v) { sort(v.begin(), v.end(), greater<int>()); });
+        row("radixSort", ints, ie, [](vector<int>& v) { radixSort(v.data(), v.size(), true); });
+        row("mergeSort", ints, ie, [](vector<int>& v) { mergeSort(v.data(), v.size(), greater<int>()); });
+        row("parallelSort", ints, ie, [&](vector<int>& v) {
+            parallelSort(v.data(), v.size(), greater<int>(), threads);
+        });
+
+        cout << "  pair<int,int>, comp\n";
+        vector<pair<int,int>> pe = pairs;
+        sort(pe.begin(), pe.end(), comp);
+        row("std::sort", pairs, pe, [](vector<pair<int,int>>& v) { sort(v.begin(), v.end(), comp); });
+        row("radixSortPairs", pairs, pe, [](vector<pair<int,int>>& v) { radixSortPairs(v.data(), v.size()); });
+        row("parallelSort", pairs, pe, [&](vector<pair<int,int>>& v) {
+            parallelSort(v.data(), v.size(), comp, threads);
+        });
+    }
+    return 0;
+}
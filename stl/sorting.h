@@ -0,0 +1,308 @@
+#pragma once
+#include <bits/stdc++.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/*
+========================================
+ SORT ENGINES
+----------------------------------------
+ radixSort(int*, n, descending)
+   LSD radix sort, 11 bits a pass (3 for int, 6 for 64-bit keys; the
+   2048 counters of a pass stay in L1). The sign bit is flipped (and for
+   descending every other bit too) so the keys sort as unsigned. One
+   read builds every pass's histogram; a pass where all keys share
+   the digit is skipped.
+ radixSortPairs(pair<int, int>*, n)
+   Algorithms.cpp's comp order (second ascending, then first
+   descending) as a single 64-bit key: second's bits on top, first's
+   inverted bits below. The key is the pair, so nothing rides along.
+
+ mergeSort(a, n, cmp)
+   bottom-up. Blocks of 8 start out sorted by a 19
+   comparator network with branch-free compare-exchange. For int
+   with std::less / std::greater on AVX2, the same network runs on
+   8 registers at once (64 ints, one column each), and an 8x8
+   transpose turns the columns into runs.
+ parallelSort(a, n, cmp, threads)
+   each thread merge-sorts one slice, then log2(threads) rounds of
+   pairwise merges. Each merge is cut into equal pieces by merge path
+   (a binary search along the output diagonal), so all threads stay
+   busy down to the last round.
+
+ Like std::sort, the merge sorts are not stable (the networks swap
+ across equal elements). For ints and for comp's pairs, equal means
+ identical, so every engine's output matches std::sort's exactly.
+========================================
+*/
+
+template <class F>
+void forEachThread(int threads, F f) {
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++) pool.emplace_back(f, t);
+    f(0);
+    for (auto& th : pool) th.join();
+}
+
+/* ---------- Radix ---------- */
+
+/*
+ K: uint32_t or uint64_t; tmp holds n keys. Only bits from lowBit up
+ are sorted on; LSD is stable, so keys already in order on the bits
+ below (e.g. a row index there) stay in that order.
+*/
+template <class K>
+void radixSortKeys(K* a, K* tmp, size_t n, int lowBit = 0) {
+    constexpr int BITS = 11, BUCKETS = 1 << BITS;
+    const int PASSES = ((int)(8 * sizeof(K)) - lowBit + BITS - 1) / BITS;
+    if (n < 2 || PASSES <= 0) return;
+    std::vector<size_t> count(PASSES * BUCKETS);
+    for (size_t i = 0; i < n; i++)
+        for (int p = 0; p < PASSES; p++)
+            count[p * BUCKETS + ((a[i] >> (lowBit + BITS * p)) & (BUCKETS - 1))]++;
+
+    K* src = a;
+    K* dst = tmp;
+    for (int p = 0; p < PASSES; p++) {
+        int shift = lowBit + BITS * p;
+        size_t* c = count.data() + p * BUCKETS;
+        if (c[(src[0] >> shift) & (BUCKETS - 1)] == n) continue;
+        size_t sum = 0;
+        for (int d = 0; d < BUCKETS; d++) {
+            size_t k = c[d];
+            c[d] = sum;
+            sum += k;
+        }
+        for (size_t i = 0; i < n; i++) dst[c[(src[i] >> shift) & (BUCKETS - 1)]++] = src[i];
+        std::swap(src, dst);
+    }
+    if (src != a) memcpy(a, src, n * sizeof(K));
+}
+
+// same order as sort(a, a + n) or, descending, sort(..., greater<int>())
+inline void radixSort(int* a, size_t n, bool descending = false) {
+    uint32_t mask = descending ? 0x7fffffffu : 0x80000000u;
+    uint32_t* u = reinterpret_cast<uint32_t*>(a);
+    for (size_t i = 0; i < n; i++) u[i] ^= mask;
+    std::vector<uint32_t> tmp(n);
+    radixSortKeys(u, tmp.data(), n);
+    for (size_t i = 0; i < n; i++) u[i] ^= mask;
+}
+
+// unsigned order of pairKey = (second asc, first desc)
+inline uint64_t pairKey(const std::pair<int, int>& p) {
+    return (uint64_t)((uint32_t)p.second ^ 0x80000000u) << 32 |
+           ((uint32_t)p.first ^ 0x7fffffffu);
+}
+
+inline std::pair<int, int> pairFromKey(uint64_t k) {
+    return {(int)((uint32_t)k ^ 0x7fffffffu), (int)((uint32_t)(k >> 32) ^ 0x80000000u)};
+}
+
+// same order as sort(a, a + n, comp) from Algorithms.cpp
+inline void radixSortPairs(std::pair<int, int>* a, size_t n) {
+    std::vector<uint64_t> keys(n), tmp(n);
+    for (size_t i = 0; i < n; i++) keys[i] = pairKey(a[i]);
+    radixSortKeys(keys.data(), tmp.data(), n);
+    for (size_t i = 0; i < n; i++) a[i] = pairFromKey(keys[i]);
+}
+
+/* ---------- Sorting networks ---------- */
+
+template <class T, class Cmp>
+inline void compareExchange(T& a, T& b, Cmp cmp) {
+    bool swap = cmp(b, a);
+    T lo = swap ? b : a;
+    T hi = swap ? a : b;
+    a = lo;
+    b = hi;
+}
+
+// Knuth's 19 comparators for 8 inputs, layer by layer
+inline constexpr int NETWORK8[19][2] = {
+    {0, 2}, {1, 3}, {4, 6}, {5, 7}, {0, 4}, {1, 5}, {2, 6}, {3, 7},
+    {0, 1}, {2, 3}, {4, 5}, {6, 7}, {2, 4}, {3, 5}, {1, 4}, {3, 6},
+    {1, 2}, {3, 4}, {5, 6}};
+
+template <class T, class Cmp>
+inline void sortNetwork8(T* a, Cmp cmp) {
+    for (auto& c : NETWORK8) compareExchange(a[c[0]], a[c[1]], cmp);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// every 64-int block of a -> 8 sorted runs of 8
+template <bool Descending>
+__attribute__((target("avx2"))) void sortRuns8Avx2(int* a, size_t blocks) {
+    for (size_t b = 0; b < blocks; b++, a += 64) {
+        __m256i r[8];
+        for (int i = 0; i < 8; i++) r[i] = _mm256_loadu_si256((const __m256i*)(a + 8 * i));
+        for (auto& c : NETWORK8) {
+            __m256i lo = _mm256_min_epi32(r[c[0]], r[c[1]]);
+            __m256i hi = _mm256_max_epi32(r[c[0]], r[c[1]]);
+            r[c[0]] = Descending ? hi : lo;
+            r[c[1]] = Descending ? lo : hi;
+        }
+        // transpose: column j -> run j
+        __m256i t[8], u[8];
+        for (int i = 0; i < 8; i += 2) {
+            t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+            t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+        }
+        for (int i = 0; i < 8; i += 4) {
+            u[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+            u[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+            u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+            u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+        }
+        for (int i = 0; i < 4; i++) {
+            r[i] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x20);
+            r[i + 4] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x31);
+        }
+        for (int i = 0; i < 8; i++) _mm256_storeu_si256((__m256i*)(a + 8 * i), r[i]);
+    }
+}
+#endif
+
+/* ---------- Merge sort ---------- */
+
+// stable: on ties a's element goes first
+template <class T, class Cmp>
+inline void mergeRuns(const T* a, size_t na, const T* b, size_t nb, T* out, Cmp cmp) {
+    if (na && nb && !cmp(b[0], a[na - 1])) {   // already in order
+        std::copy(b, b + nb, std::copy(a, a + na, out));
+        return;
+    }
+    size_t i = 0, j = 0;
+    while (i < na && j < nb) {
+        bool takeB = cmp(b[j], a[i]);
+        *out++ = takeB ? b[j] : a[i];
+        j += takeB;
+        i += !takeB;
+    }
+    out = std::copy(a + i, a + na, out);
+    std::copy(b + j, b + nb, out);
+}
+
+// a[0, n) -> runs of 8 (the last one shorter)
+template <class T, class Cmp>
+void sortRuns8(T* a, size_t n, Cmp cmp) {
+    size_t i = 0;
+#if defined(__x86_64__) || defined(__i386__)
+    if constexpr (std::is_same_v<T, int> && (std::is_same_v<Cmp, std::less<int>> ||
+                                             std::is_same_v<Cmp, std::greater<int>>)) {
+        if (__builtin_cpu_supports("avx2")) {
+            sortRuns8Avx2<std::is_same_v<Cmp, std::greater<int>>>(a, n / 64);
+            i = n / 64 * 64;
+        }
+    }
+#endif
+    for (; i + 8 <= n; i += 8) sortNetwork8(a + i, cmp);
+    // insertion sort the tail
+    for (size_t j = i + 1; j < n; j++) {
+        T v = a[j];
+        size_t k = j;
+        for (; k > i && cmp(v, a[k - 1]); k--) a[k] = a[k - 1];
+        a[k] = v;
+    }
+}
+
+// tmp holds n elements; the result ends up in a
+template <class T, class Cmp>
+void mergeSort(T* a, T* tmp, size_t n, Cmp cmp) {
+    sortRuns8(a, n, cmp);
+    T* src = a;
+    T* dst = tmp;
+    for (size_t width = 8; width < n; width *= 2) {
+        for (size_t lo = 0; lo < n; lo += 2 * width) {
+            size_t mid = std::min(n, lo + width), hi = std::min(n, lo + 2 * width);
+            mergeRuns(src + lo, mid - lo, src + mid, hi - mid, dst + lo, cmp);
+        }
+        std::swap(src, dst);
+    }
+    if (src != a) std::copy(src, src + n, a);
+}
+
+template <class T, class Cmp = std::less<T>>
+void mergeSort(T* a, size_t n, Cmp cmp = Cmp()) {
+    std::vector<T> tmp(n);
+    mergeSort(a, tmp.data(), n, cmp);
+}
+
+/*
+ Merge path: how many of the first d outputs of merging a and b come
+ from a (ties to a, as in mergeRuns)
+*/
+template <class T, class Cmp>
+size_t mergeSplit(const T* a, size_t na, const T* b, size_t nb, size_t d, Cmp cmp) {
+    size_t lo = d > nb ? d - nb : 0, hi = std::min(d, na);
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (!cmp(b[d - mid - 1], a[mid])) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+template <class T, class Cmp = std::less<T>>
+void parallelSort(T* a, size_t n, Cmp cmp = Cmp(), int threads = 1) {
+    threads = (int)std::max<size_t>(1, std::min<size_t>(threads, n / (1 << 16)));
+    std::vector<T> tmp(n);
+    if (threads == 1) {
+        mergeSort(a, tmp.data(), n, cmp);
+        return;
+    }
+
+    std::vector<size_t> bounds(threads + 1);
+    for (int t = 0; t <= threads; t++) bounds[t] = n * t / threads;
+    forEachThread(threads, [&](int t) {
+        mergeSort(a + bounds[t], tmp.data() + bounds[t], bounds[t + 1] - bounds[t], cmp);
+    });
+
+    struct Piece {
+        size_t aFrom, aTo, bFrom, bTo, out;
+    };
+    T* src = a;
+    T* dst = tmp.data();
+    size_t pieceSize = (n + threads - 1) / threads;
+    while (bounds.size() > 2) {
+        // cut every pair's merge into pieces of about n / threads outputs
+        std::vector<Piece> pieces;
+        std::vector<size_t> next;
+        for (size_t r = 0; r + 1 < bounds.size(); r += 2) {
+            next.push_back(bounds[r]);
+            // an odd run out merges with nothing, i.e. is copied
+            size_t lo = bounds[r], mid = bounds[r + 1];
+            size_t hi = r + 2 < bounds.size() ? bounds[r + 2] : mid;
+            size_t na = mid - lo, nb = hi - mid;
+            size_t prevA = 0;
+            for (size_t d = 0; d < na + nb;) {
+                size_t e = std::min(na + nb, d + pieceSize);
+                size_t takeA = mergeSplit(src + lo, na, src + mid, nb, e, cmp);
+                pieces.push_back({lo + prevA, lo + takeA, mid + (d - prevA), mid + (e - takeA),
+                                  lo + d});
+                prevA = takeA;
+                d = e;
+            }
+        }
+        next.push_back(n);
+
+        std::atomic<size_t> nextPiece{0};
+        forEachThread(threads, [&](int) {
+            for (size_t p; (p = nextPiece++) < pieces.size();) {
+                const Piece& q = pieces[p];
+                mergeRuns(src + q.aFrom, q.aTo - q.aFrom, src + q.bFrom, q.bTo - q.bFrom,
+                          dst + q.out, cmp);
+            }
+        });
+        std::swap(src, dst);
+        bounds.swap(next);
+    }
+
+    if (src != a) {
+        forEachThread(threads, [&](int t) {
+            size_t b = n * t / threads, e = n * (t + 1) / threads;
+            std::copy(src + b, src + e, a + b);
+        });
+    }
+}
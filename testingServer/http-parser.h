@@ -0,0 +1,280 @@
+#pragma once
+#include <bits/stdc++.h>
+
+/*
+========================================
+ HTTP REQUEST PARSER
+----------------------------------------
+ - incremental: feed it the unconsumed bytes of a connection
+   buffer after every read, it remembers how far it got
+ - zero copy: method / path / headers / body are string_views
+   into that buffer, nothing is copied out
+ - query string is percent-decoded IN PLACE (decoded text is
+   never longer than the encoded text), params are views too
+ - no heap allocation: fixed arrays for headers and params
+
+ state machine:
+   REQUEST_LINE -> HEADERS -> BODY -> (DONE)
+
+ Views stay valid until the buffer is modified again, so handle
+ the request before reading more into the buffer.
+========================================
+*/
+
+struct HttpRequest {
+    static const int MAX_HEADERS = 32;
+    static const int MAX_PARAMS = 16;
+
+    struct Field {
+        std::string_view name;
+        std::string_view value;
+    };
+
+    std::string_view method;
+    std::string_view path;    // decoded, without the query
+    std::string_view query;   // decoded, raw "a=1&b=2" text
+    std::string_view body;
+    bool keep_alive = true;
+
+    int header_count = 0;
+    Field headers[MAX_HEADERS];
+    int param_count = 0;
+    Field params[MAX_PARAMS];
+
+    std::optional<std::string_view> param(std::string_view key) const {
+        for (int i = 0; i < param_count; i++)
+            if (params[i].name == key) return params[i].value;
+        return std::nullopt;
+    }
+
+    std::optional<std::string_view> header(std::string_view name) const;
+};
+
+inline bool iequals(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++)
+        if (tolower((unsigned char)a[i]) != tolower((unsigned char)b[i]))
+            return false;
+    return true;
+}
+
+inline std::optional<std::string_view>
+HttpRequest::header(std::string_view name) const {
+    for (int i = 0; i < header_count; i++)
+        if (iequals(headers[i].name, name)) return headers[i].value;
+    return std::nullopt;
+}
+
+// Decode %XX and '+' in place, returns the new length
+inline size_t percent_decode(char* s, size_t len, bool plus_is_space) {
+    auto hex = [](char c) -> int {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    };
+
+    size_t out = 0;
+    for (size_t i = 0; i < len; i++) {
+        char c = s[i];
+        if (c == '%' && i + 2 < len &&
+            hex(s[i + 1]) >= 0 && hex(s[i + 2]) >= 0) {
+            c = (char)(hex(s[i + 1]) * 16 + hex(s[i + 2]));
+            i += 2;
+        } else if (c == '+' && plus_is_space) {
+            c = ' ';
+        }
+        s[out++] = c;
+    }
+    return out;
+}
+
+class HttpParser {
+public:
+    enum Status { NEED_MORE, DONE, ERROR };
+
+    static const size_t MAX_HEAD = 64 * 1024;
+    static const size_t MAX_BODY = 16 * 1024 * 1024;
+
+    /*
+     data[0..len) are the unconsumed bytes of the connection buffer,
+     starting at the current request. Call again with the same start
+     (the buffer may have moved) once more bytes have arrived.
+    */
+    Status parse(char* data, size_t len) {
+        while (state != BODY) {
+            const void* nl = memchr(data + scan, '\n', len - scan);
+            if (!nl) {
+                scan = len;
+                return len > MAX_HEAD ? fail() : NEED_MORE;
+            }
+            size_t line_end = (const char*)nl - data;
+            size_t line_start = line_pos;
+            size_t n = line_end - line_start;
+            if (n > 0 && data[line_end - 1] == '\r') n--;
+            line_pos = scan = line_end + 1;
+            if (line_pos > MAX_HEAD) return fail();
+
+            if (state == REQUEST_LINE) {
+                if (n == 0) continue;   // stray CRLF between requests
+                if (!request_line(data, line_start, n)) return fail();
+                state = HEADERS;
+            } else if (n == 0) {
+                state = BODY;
+                body_start = line_pos;
+            } else if (!header_line(data, line_start, n)) {
+                return fail();
+            }
+        }
+
+        if (len - body_start < content_length) return NEED_MORE;
+        finish(data);
+        return DONE;
+    }
+
+    const HttpRequest& request() const { return req; }
+
+    // bytes taken by the request that just completed
+    size_t consumed() const { return body_start + content_length; }
+
+    void reset() { *this = HttpParser(); }
+
+private:
+    enum State { REQUEST_LINE, HEADERS, BODY };
+
+    struct Span {
+        size_t pos = 0;
+        size_t len = 0;
+    };
+
+    State state = REQUEST_LINE;
+    size_t scan = 0;        // memchr resumes here
+    size_t line_pos = 0;    // start of the current line
+    size_t body_start = 0;
+    size_t content_length = 0;
+    bool http10 = false;
+    int connection = 0;     // -1 close, 1 keep-alive, 0 not given
+
+    Span method, target;
+    int header_count = 0;
+    Span header_name[HttpRequest::MAX_HEADERS];
+    Span header_value[HttpRequest::MAX_HEADERS];
+
+    HttpRequest req;
+
+    Status fail() {
+        reset();
+        return ERROR;
+    }
+
+    static std::string_view view(char* data, Span s) {
+        return std::string_view(data + s.pos, s.len);
+    }
+
+    // METHOD SP TARGET SP HTTP/1.x
+    bool request_line(char* data, size_t pos, size_t n) {
+        std::string_view line(data + pos, n);
+        size_t sp1 = line.find(' ');
+        size_t sp2 = line.rfind(' ');
+        if (sp1 == std::string_view::npos || sp1 == 0 || sp2 <= sp1 + 1)
+            return false;
+
+        std::string_view version = line.substr(sp2 + 1);
+        if (version == "HTTP/1.0") http10 = true;
+        else if (version != "HTTP/1.1") return false;
+
+        method = {pos, sp1};
+        target = {pos + sp1 + 1, sp2 - sp1 - 1};
+        return true;
+    }
+
+    bool header_line(char* data, size_t pos, size_t n) {
+        std::string_view line(data + pos, n);
+        size_t colon = line.find(':');
+        if (colon == std::string_view::npos || colon == 0) return false;
+
+        size_t v = colon + 1;
+        while (v < n && (line[v] == ' ' || line[v] == '\t')) v++;
+        size_t e = n;
+        while (e > v && (line[e - 1] == ' ' || line[e - 1] == '\t')) e--;
+
+        std::string_view name = line.substr(0, colon);
+        std::string_view value = line.substr(v, e - v);
+
+        if (iequals(name, "Content-Length")) {
+            size_t len = 0;
+            auto r = std::from_chars(value.data(), value.data() + value.size(),
+                                     len);
+            if (r.ec != std::errc() || r.ptr != value.data() + value.size() ||
+                len > MAX_BODY)
+                return false;
+            content_length = len;
+        } else if (iequals(name, "Transfer-Encoding")) {
+            return false;   // chunked request bodies are not supported
+        } else if (iequals(name, "Connection")) {
+            if (iequals(value, "close")) connection = -1;
+            else if (iequals(value, "keep-alive")) connection = 1;
+        }
+
+        if (header_count < HttpRequest::MAX_HEADERS) {
+            header_name[header_count] = {pos, colon};
+            header_value[header_count] = {pos + v, e - v};
+            header_count++;
+        }
+        return true;
+    }
+
+    // Build the views and decode path / query in place
+    void finish(char* data) {
+        req = HttpRequest();
+        req.method = view(data, method);
+        req.keep_alive = connection == 0 ? !http10 : connection == 1;
+        req.body = std::string_view(data + body_start, content_length);
+
+        req.header_count = header_count;
+        for (int i = 0; i < header_count; i++)
+            req.headers[i] = {view(data, header_name[i]),
+                              view(data, header_value[i])};
+
+        char* t = data + target.pos;
+        size_t q = std::string_view(t, target.len).find('?');
+        size_t path_len = q == std::string_view::npos ? target.len : q;
+        req.path = std::string_view(t, percent_decode(t, path_len, false));
+
+        if (q == std::string_view::npos) return;
+
+        // decode each key / value separately so '&' and '=' inside
+        // encoded text cannot split a pair
+        char* s = t + q + 1;
+        size_t rest = target.len - q - 1;
+        char* out = s;
+        while (rest > 0) {
+            size_t amp = std::string_view(s, rest).find('&');
+            size_t pair_len = amp == std::string_view::npos ? rest : amp;
+            std::string_view pair(s, pair_len);
+            size_t eq = pair.find('=');
+
+            if (eq != std::string_view::npos &&
+                req.param_count < HttpRequest::MAX_PARAMS) {
+                size_t kl = percent_decode(s, eq, true);
+                size_t vl = percent_decode(s + eq + 1, pair_len - eq - 1, true);
+                // move the decoded pair down, keeps query contiguous
+                char* k = out;
+                memmove(out, s, kl);
+                out += kl;
+                *out++ = '=';
+                char* val = out;
+                memmove(out, s + eq + 1, vl);
+                out += vl;
+                req.params[req.param_count++] = {
+                    std::string_view(k, kl), std::string_view(val, vl)};
+                if (amp != std::string_view::npos) *out++ = '&';
+            }
+
+            if (amp == std::string_view::npos) break;
+            s += amp + 1;
+            rest -= amp + 1;
+        }
+        req.query = std::string_view(t + q + 1, out - (t + q + 1));
+    }
+};
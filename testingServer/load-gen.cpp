@@ -0,0 +1,305 @@
+#include <bits/stdc++.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+/*
+========================================
+ LOAD GENERATOR for test-server
+----------------------------------------
+ usage:
+   ./load-gen [-P port] [-c conns] [-d seconds] [-t threads]
+              [-p pipeline] [-k 0|1] [-X method] [-u path] [-B n]
+
+   -c  concurrent connections        (default 64)
+   -t  client threads, conns are split between them (default 1)
+   -d  test duration in seconds      (default 5)
+   -p  requests in flight per conn   (default 1)
+   -k  1 = keep-alive, 0 = new connection per request
+       (0 is the only mode the old blocking loop supports)
+   -X  request method                (default GET)
+   -u  request path                  (default /users?id=1)
+   -B  POST /users/batch with n creates per request
+       (compare ops/sec with -X POST -u /users?name=...)
+
+ prints requests/sec, ops/sec and p50 / p99 / max latency
+========================================
+*/
+
+struct Options {
+    int port = 8080;
+    int conns = 64;
+    int seconds = 5;
+    int threads = 1;
+    int pipeline = 1;
+    bool keep_alive = true;
+    string method = "GET";
+    string path = "/users?id=1";
+    int batch = 0;
+};
+
+struct Client {
+    int fd = -1;
+    string in;
+    string out;
+    size_t out_pos = 0;
+    deque<Clock::time_point> sent;   // send time of each request in flight
+};
+
+// Results of one client thread
+struct Stats {
+    vector<double> latencies_us;
+    long long completed = 0;
+    long long errors = 0;
+};
+
+Options opt;
+string request_text;
+
+int connect_to_server() {
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(opt.port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+    int r = connect(fd, (sockaddr*)&addr, sizeof(addr));
+    if (r < 0 && errno != EINPROGRESS) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+void queue_requests(Client& c) {
+    while ((int)c.sent.size() < opt.pipeline) {
+        c.out += request_text;
+        c.sent.push_back(Clock::now());
+        if (!opt.keep_alive) break;   // one request per connection
+    }
+}
+
+bool open_client(int epfd, Client& c) {
+    c.fd = connect_to_server();
+    if (c.fd < 0) return false;
+    c.in.clear();
+    c.out.clear();
+    c.out_pos = 0;
+    c.sent.clear();
+    queue_requests(c);
+
+    epoll_event ev{};
+    ev.events = EPOLLIN | EPOLLOUT | EPOLLET;
+    ev.data.ptr = &c;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, c.fd, &ev);
+    return true;
+}
+
+void close_client(int epfd, Client& c) {
+    epoll_ctl(epfd, EPOLL_CTL_DEL, c.fd, nullptr);
+    close(c.fd);
+    c.fd = -1;
+}
+
+bool flush(Client& c) {
+    while (c.out_pos < c.out.size()) {
+        ssize_t n = write(c.fd, c.out.data() + c.out_pos,
+                          c.out.size() - c.out_pos);
+        if (n > 0) {
+            c.out_pos += n;
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+    }
+    c.out.clear();
+    c.out_pos = 0;
+    return true;
+}
+
+// Size of a chunked body starting at `pos`, 0 if not fully read yet
+size_t chunked_length(const string& in, size_t pos) {
+    size_t p = pos;
+    while (true) {
+        size_t eol = in.find("\r\n", p);
+        if (eol == string::npos) return 0;
+        size_t len = strtoul(in.c_str() + p, nullptr, 16);
+        p = eol + 2 + len + 2;
+        if (p > in.size()) return 0;
+        if (len == 0) return p - pos;
+    }
+}
+
+// Pull complete responses out of c.in. Returns how many were consumed.
+int consume_responses(Client& c, Stats& st) {
+    int done = 0;
+    while (!c.sent.empty()) {
+        size_t end = c.in.find("\r\n\r\n");
+        if (end == string::npos) break;
+
+        size_t body = 0;
+        size_t cl = c.in.find("Content-Length:");
+        size_t te = c.in.find("Transfer-Encoding: chunked");
+        if (cl != string::npos && cl < end)
+            body = strtoul(c.in.c_str() + cl + 15, nullptr, 10);
+        else if (te != string::npos && te < end) {
+            body = chunked_length(c.in, end + 4);
+            if (body == 0) break;
+        }
+        if (c.in.size() < end + 4 + body) break;
+
+        auto us = chrono::duration<double, micro>(
+            Clock::now() - c.sent.front()).count();
+        st.latencies_us.push_back(us);
+        c.sent.pop_front();
+        c.in.erase(0, end + 4 + body);
+        st.completed++;
+        done++;
+    }
+    return done;
+}
+
+// Returns false when the connection has to be reopened.
+bool on_event(Client& c, Stats& st) {
+    char buffer[16384];
+    bool eof = false;
+    while (true) {
+        ssize_t n = read(c.fd, buffer, sizeof(buffer));
+        if (n > 0) {
+            c.in.append(buffer, n);
+            continue;
+        }
+        if (n == 0) eof = true;
+        else if (errno == EINTR) continue;
+        else if (errno != EAGAIN && errno != EWOULDBLOCK) eof = true;
+        break;
+    }
+
+    consume_responses(c, st);
+
+    if (!opt.keep_alive && c.sent.empty()) return false;
+    if (eof) {
+        st.errors += c.sent.size();
+        return false;
+    }
+
+    queue_requests(c);
+    return flush(c);
+}
+
+double percentile(vector<double>& v, double p) {
+    if (v.empty()) return 0;
+    size_t k = min(v.size() - 1, (size_t)(p / 100.0 * v.size()));
+    nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+// One client thread: its own epoll instance driving `conns` connections
+void run_clients(int conns, Clock::time_point stop, Stats& st) {
+    int epfd = epoll_create1(0);
+
+    vector<Client> clients(conns);
+    for (auto& c : clients)
+        if (!open_client(epfd, c)) {
+            perror("connect");
+            st.errors++;
+        }
+
+    vector<epoll_event> events(1024);
+    while (Clock::now() < stop) {
+        int n = epoll_wait(epfd, events.data(), events.size(), 100);
+        for (int i = 0; i < n; i++) {
+            Client& c = *(Client*)events[i].data.ptr;
+            if (c.fd < 0) continue;
+            if (!on_event(c, st)) {
+                close_client(epfd, c);
+                open_client(epfd, c);
+            }
+        }
+    }
+
+    for (auto& c : clients)
+        if (c.fd >= 0) close(c.fd);
+    close(epfd);
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string f = argv[i];
+        string v = argv[i + 1];
+        if (f == "-P") opt.port = stoi(v);
+        else if (f == "-c") opt.conns = stoi(v);
+        else if (f == "-d") opt.seconds = stoi(v);
+        else if (f == "-t") opt.threads = max(1, stoi(v));
+        else if (f == "-p") opt.pipeline = max(1, stoi(v));
+        else if (f == "-k") opt.keep_alive = v != "0";
+        else if (f == "-X") opt.method = v;
+        else if (f == "-u") opt.path = v;
+        else if (f == "-B") opt.batch = max(0, stoi(v));
+    }
+    if (!opt.keep_alive) opt.pipeline = 1;
+    opt.threads = min(opt.threads, opt.conns);
+
+    string body;
+    if (opt.batch > 0) {
+        opt.method = "POST";
+        opt.path = "/users/batch";
+        for (int i = 0; i < opt.batch; i++)
+            body += "C user" + to_string(i) + "\n";
+    }
+
+    request_text = opt.method + " " + opt.path +
+                   " HTTP/1.1\r\nHost: localhost\r\n" +
+                   (opt.keep_alive ? "" : "Connection: close\r\n") +
+                   (body.empty() ? "" : "Content-Length: " +
+                                        to_string(body.size()) + "\r\n") +
+                   "\r\n" + body;
+
+    signal(SIGPIPE, SIG_IGN);
+
+    auto start = Clock::now();
+    auto stop = start + chrono::seconds(opt.seconds);
+
+    vector<Stats> stats(opt.threads);
+    vector<thread> pool;
+    for (int t = 0; t < opt.threads; t++) {
+        int conns = opt.conns / opt.threads +
+                    (t < opt.conns % opt.threads ? 1 : 0);
+        pool.emplace_back(run_clients, conns, stop, ref(stats[t]));
+    }
+    for (auto& t : pool) t.join();
+
+    Stats total;
+    for (auto& st : stats) {
+        total.completed += st.completed;
+        total.errors += st.errors;
+        total.latencies_us.insert(total.latencies_us.end(),
+                                  st.latencies_us.begin(),
+                                  st.latencies_us.end());
+    }
+
+    double secs = chrono::duration<double>(Clock::now() - start).count();
+    cout << fixed << setprecision(1);
+    cout << "connections : " << opt.conns
+         << (opt.keep_alive ? " keep-alive" : " close-per-request")
+         << ", pipeline " << opt.pipeline
+         << ", " << opt.threads << " client thread(s)\n";
+    cout << "requests    : " << total.completed
+         << " (" << total.errors << " errors)\n";
+    cout << "req/sec     : " << total.completed / secs << "\n";
+    cout << "ops/sec     : " << total.completed * max(1, opt.batch) / secs
+         << "\n";
+    cout << "latency us  : p50 " << percentile(total.latencies_us, 50)
+         << "  p99 " << percentile(total.latencies_us, 99)
+         << "  max " << percentile(total.latencies_us, 100) << "\n";
+    return 0;
+}
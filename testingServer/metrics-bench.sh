@@ -0,0 +1,36 @@
+#!/bin/sh
+# Metrics overhead: same load with /metrics collection on and off.
+# Reports load-gen throughput and the server's own CPU time per
+# request (from /proc, less noisy than req/sec when client and
+# server share cores). Build test-server and load-gen first.
+#
+# usage: ./metrics-bench.sh [port] [seconds] [rounds]
+
+cd "$(dirname "$0")"
+PORT=${1:-8091}
+SECS=${2:-5}
+ROUNDS=${3:-3}
+TICK=$(getconf CLK_TCK)
+
+for R in $(seq "$ROUNDS"); do
+    for M in on off; do
+        ./test-server "$PORT" 1 -M "$M" > /dev/null &
+        SERVER=$!
+        sleep 0.3
+        ./load-gen -P "$PORT" -c 4 -d 1 -X POST -u "/users?name=seed" > /dev/null
+
+        START=$(awk '{print $14 + $15}' /proc/$SERVER/stat)
+        OUT=$(./load-gen -P "$PORT" -c 64 -p 8 -d "$SECS")
+        END=$(awk '{print $14 + $15}' /proc/$SERVER/stat)
+
+        REQS=$(echo "$OUT" | awk '/^requests/ {print $3}')
+        RPS=$(echo "$OUT" | awk '/^req\/sec/ {print $3}')
+        echo "$OUT" | awk -v m="$M" -v rps="$RPS" -v reqs="$REQS" \
+            -v cpu=$((END - START)) -v tick="$TICK" 'NR == 1 {
+            printf "metrics %-3s  %10.0f req/s  %6.3f us cpu/request\n",
+                   m, rps, cpu / tick * 1e6 / reqs }'
+
+        kill "$SERVER"
+        wait "$SERVER" 2> /dev/null || true
+    done
+done
@@ -0,0 +1,174 @@
+#pragma once
+#include <bits/stdc++.h>
+
+/*
+========================================
+ METRICS
+----------------------------------------
+ - every worker thread owns one ThreadMetrics block and is the
+   only writer to it: plain relaxed load + store, no atomic RMW,
+   no locks, no shared cache lines on the hot path
+ - /metrics sums all blocks when it is asked (readers may see a
+   value a few increments old, never a torn one)
+ - latency histograms are HDR style: 16 linear sub-buckets per
+   power of two, so any recorded value is off by at most 1/16
+ - a clock read costs ~20-40 ns, as much as parsing a request, so
+   phases are timed on 1 of every SAMPLE_EVERY requests / writes;
+   counters are exact, histograms hold the samples
+========================================
+*/
+
+enum Route {
+    ROUTE_CREATE,
+    ROUTE_GET,
+    ROUTE_LIST,
+    ROUTE_UPDATE,
+    ROUTE_DELETE,
+    ROUTE_BATCH,
+    ROUTE_METRICS,
+    ROUTE_NOT_FOUND,
+    ROUTE_BAD_REQUEST,
+    ROUTE_COUNT
+};
+
+const char* const ROUTE_NAMES[ROUTE_COUNT] = {
+    "create", "get", "list", "update", "delete",
+    "batch", "metrics", "not_found", "bad_request",
+};
+
+enum Phase { PHASE_PARSE, PHASE_HANDLER, PHASE_WRITE, PHASE_COUNT };
+
+const char* const PHASE_NAMES[PHASE_COUNT] = {"parse", "handler", "write"};
+
+// Single-writer counter
+struct Counter {
+    std::atomic<uint64_t> v{0};
+
+    void add(uint64_t n) {
+        v.store(v.load(std::memory_order_relaxed) + n,
+                std::memory_order_relaxed);
+    }
+    uint64_t get() const { return v.load(std::memory_order_relaxed); }
+};
+
+struct Histogram {
+    static const int SUB = 16;                   // sub-buckets per 2^k
+    static const int BUCKETS = (64 - 3) * SUB;   // covers all of uint64
+
+    Counter counts[BUCKETS];
+
+    static int bucket_of(uint64_t v) {
+        if (v < SUB) return (int)v;
+        int k = 63 - __builtin_clzll(v);          // k >= 4
+        return (k - 3) * SUB + (int)((v >> (k - 4)) & (SUB - 1));
+    }
+
+    // largest value that lands in bucket i
+    static uint64_t upper_of(int i) {
+        if (i < SUB) return i;
+        int k = i / SUB + 3;
+        uint64_t low = (uint64_t)(SUB + i % SUB) << (k - 4);
+        return low + (1ull << (k - 4)) - 1;
+    }
+
+    void record(uint64_t v) { counts[bucket_of(v)].add(1); }
+};
+
+const uint32_t SAMPLE_EVERY = 64;   // power of two
+
+struct alignas(64) ThreadMetrics {
+    uint32_t tick = 0;   // owner thread only
+
+    bool sample() { return (++tick & (SAMPLE_EVERY - 1)) == 0; }
+
+    Counter requests[ROUTE_COUNT];
+    Counter conns_opened;
+    Counter conns_closed;
+    Counter bytes_in;
+    Counter bytes_out;
+    Histogram latency[PHASE_COUNT];
+};
+
+/*
+ Global switch (-M off) so the overhead can be measured.
+ Set once before the workers start.
+*/
+inline bool metrics_on = true;
+
+inline std::mutex metrics_registry_m;
+inline std::vector<std::unique_ptr<ThreadMetrics>> metrics_registry;
+inline thread_local ThreadMetrics* thread_metrics = nullptr;
+
+// Give the calling thread its own block (call once per worker)
+inline void metrics_register_thread() {
+    std::lock_guard<std::mutex> lock(metrics_registry_m);
+    metrics_registry.push_back(std::make_unique<ThreadMetrics>());
+    thread_metrics = metrics_registry.back().get();
+}
+
+inline uint64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// Prometheus text format
+inline std::string metrics_text() {
+    std::lock_guard<std::mutex> lock(metrics_registry_m);
+    auto sum = [&](auto field) {
+        uint64_t total = 0;
+        for (auto& t : metrics_registry) total += field(*t).get();
+        return total;
+    };
+
+    std::string out;
+    auto line = [&](const std::string& name, uint64_t v) {
+        out += name + " " + std::to_string(v) + "\n";
+    };
+
+    for (int r = 0; r < ROUTE_COUNT; r++)
+        line(std::string("requests_total{route=\"") + ROUTE_NAMES[r] + "\"}",
+             sum([&](ThreadMetrics& t) -> Counter& { return t.requests[r]; }));
+
+    uint64_t opened = sum([](ThreadMetrics& t) -> Counter& {
+        return t.conns_opened;
+    });
+    uint64_t closed = sum([](ThreadMetrics& t) -> Counter& {
+        return t.conns_closed;
+    });
+    line("connections_total", opened);
+    line("connections_open", opened - std::min(opened, closed));
+    line("bytes_in_total",
+         sum([](ThreadMetrics& t) -> Counter& { return t.bytes_in; }));
+    line("bytes_out_total",
+         sum([](ThreadMetrics& t) -> Counter& { return t.bytes_out; }));
+
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        std::vector<uint64_t> merged(Histogram::BUCKETS);
+        uint64_t count = 0;
+        for (auto& t : metrics_registry)
+            for (int i = 0; i < Histogram::BUCKETS; i++) {
+                merged[i] += t->latency[p].counts[i].get();
+                count += t->latency[p].counts[i].get();
+            }
+
+        std::string phase = PHASE_NAMES[p];
+        for (double q : {0.5, 0.99, 0.999}) {
+            uint64_t rank = (uint64_t)std::ceil(q * count);
+            uint64_t seen = 0, value = 0;
+            for (int i = 0; i < Histogram::BUCKETS && count > 0; i++) {
+                seen += merged[i];
+                if (seen >= rank) {
+                    value = Histogram::upper_of(i);
+                    break;
+                }
+            }
+            char qs[16];
+            snprintf(qs, sizeof(qs), "%g", q);
+            line("latency_ns{phase=\"" + phase + "\",quantile=\"" + qs + "\"}",
+                 value);
+        }
+        line("latency_ns_samples{phase=\"" + phase + "\"}", count);
+    }
+    return out;
+}
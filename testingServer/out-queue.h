@@ -0,0 +1,212 @@
+#pragma once
+#include <bits/stdc++.h>
+#include <sys/uio.h>
+
+/*
+========================================
+ OUTPUT QUEUE
+----------------------------------------
+ - responses are written into fixed size blocks (BLOCK bytes)
+   taken from a per-thread pool, never into growing strings
+ - flush() hands every pending block to ONE writev call,
+   so headers and body go out together without being joined
+ - chunk_write / close_chunk / end_chunked frame a body with
+   HTTP chunked encoding right inside the blocks
+
+ A block returns to the pool as soon as it has been sent.
+========================================
+*/
+
+class BlockPool {
+public:
+    static const size_t BLOCK = 16 * 1024;
+    static const size_t MAX_FREE = 1024;   // blocks kept per thread
+
+    static char* get() {
+        auto& f = free_list();
+        if (f.empty()) return new char[BLOCK];
+        char* b = f.back();
+        f.pop_back();
+        return b;
+    }
+
+    static void put(char* b) {
+        auto& f = free_list();
+        if (f.size() < MAX_FREE) f.push_back(b);
+        else delete[] b;
+    }
+
+private:
+    struct FreeList : std::vector<char*> {
+        ~FreeList() {
+            for (char* b : *this) delete[] b;
+        }
+    };
+
+    static FreeList& free_list() {
+        thread_local FreeList f;
+        return f;
+    }
+};
+
+class OutQueue {
+public:
+    static const size_t BLOCK = BlockPool::BLOCK;
+
+    OutQueue() = default;
+    OutQueue(const OutQueue&) = delete;
+    OutQueue& operator=(const OutQueue&) = delete;
+    OutQueue(OutQueue&& o) noexcept { swap(o); }
+    OutQueue& operator=(OutQueue&& o) noexcept {
+        swap(o);
+        return *this;
+    }
+    ~OutQueue() {
+        for (auto& b : blocks) BlockPool::put(b.data);
+    }
+
+    bool empty() const { return blocks.empty(); }
+    size_t block_count() const { return blocks.size(); }
+
+    void append(const char* p, size_t n) {
+        while (n > 0) {
+            Block& b = room(1);
+            size_t k = std::min(n, BLOCK - b.len);
+            memcpy(b.data + b.len, p, k);
+            b.len += k;
+            p += k;
+            n -= k;
+        }
+    }
+
+    void append(std::string_view s) { append(s.data(), s.size()); }
+
+    // Body bytes of a chunked response, split into chunks as blocks fill
+    void chunk_write(const char* p, size_t n) {
+        while (n > 0) {
+            if (chunk_open && BLOCK - blocks.back().len <= CHUNK_TAIL)
+                close_chunk();
+            if (!chunk_open) open_chunk();
+
+            Block& b = blocks.back();
+            size_t k = std::min(n, BLOCK - CHUNK_TAIL - b.len);
+            memcpy(b.data + b.len, p, k);
+            b.len += k;
+            p += k;
+            n -= k;
+        }
+    }
+
+    void chunk_write(std::string_view s) { chunk_write(s.data(), s.size()); }
+
+    // Finish the current chunk so the bytes can be sent
+    void close_chunk() {
+        if (!chunk_open) return;
+        chunk_open = false;
+
+        Block& b = blocks.back();
+        size_t payload = b.len - chunk_start - CHUNK_HEAD;
+        if (payload == 0) {
+            b.len = chunk_start;   // nothing written, drop the header
+            return;
+        }
+        // fixed width size ("0fa0\r\n"), leading zeros are allowed
+        static const char hex[] = "0123456789abcdef";
+        char* h = b.data + chunk_start;
+        for (int i = 3; i >= 0; i--) {
+            h[i] = hex[payload & 15];
+            payload >>= 4;
+        }
+        h[4] = '\r';
+        h[5] = '\n';
+        b.data[b.len++] = '\r';
+        b.data[b.len++] = '\n';
+    }
+
+    void end_chunked() {
+        close_chunk();
+        append("0\r\n\r\n", 5);
+    }
+
+    /*
+     writev everything pending. false -> the socket is dead.
+     true with !empty() -> the socket is full, wait for EPOLLOUT.
+     Bytes sent are added to *written when given.
+    */
+    bool flush(int fd, size_t* written = nullptr) {
+        close_chunk();
+        while (!blocks.empty()) {
+            iovec iov[64];
+            int n = 0;
+            for (auto& b : blocks) {
+                if (n == 64) break;
+                if (b.len == b.sent) continue;
+                iov[n].iov_base = b.data + b.sent;
+                iov[n].iov_len = b.len - b.sent;
+                n++;
+            }
+            if (n == 0) {
+                release_sent();
+                break;
+            }
+
+            ssize_t w = writev(fd, iov, n);
+            if (w < 0) {
+                if (errno == EINTR) continue;
+                return errno == EAGAIN || errno == EWOULDBLOCK;
+            }
+            if (written) *written += w;
+
+            size_t left = w;
+            for (auto& b : blocks) {
+                if (left == 0) break;
+                size_t k = std::min(left, b.len - b.sent);
+                b.sent += k;
+                left -= k;
+            }
+            release_sent();
+        }
+        return true;
+    }
+
+private:
+    static const size_t CHUNK_HEAD = 6;   // "xxxx\r\n"
+    static const size_t CHUNK_TAIL = 2;   // "\r\n"
+
+    struct Block {
+        char* data;
+        size_t len;
+        size_t sent;
+    };
+
+    std::deque<Block> blocks;
+    bool chunk_open = false;
+    size_t chunk_start = 0;
+
+    Block& room(size_t want) {
+        if (blocks.empty() || BLOCK - blocks.back().len < want)
+            blocks.push_back({BlockPool::get(), 0, 0});
+        return blocks.back();
+    }
+
+    void open_chunk() {
+        Block& b = room(64);
+        chunk_start = b.len;
+        b.len += CHUNK_HEAD;
+        chunk_open = true;
+    }
+
+    // hand fully written blocks back to the pool
+    void release_sent() {
+        while (!blocks.empty() && blocks.front().sent == blocks.front().len) {
+            BlockPool::put(blocks.front().data);
+            blocks.pop_front();
+        }
+    }
+
+    void swap(OutQueue& o) {
+        std::swap(blocks, o.blocks);
+        std::swap(chunk_open, o.chunk_open);
+        std::swap(chunk_start, o.chunk_start);
+    }
+};
@@ -0,0 +1,155 @@
+#include <bits/stdc++.h>
+#include "../bench.h"
+
+#include "persistence.h"
+#include "user-store.h"
+
+using namespace std;
+
+/*
+========================================
+ PERSISTENCE BENCHMARK
+----------------------------------------
+ 1. log write throughput per durability mode
+    (1 / 4 / 16 writer threads, SYNC writers wait for their fsync)
+ 2. cold start: snapshot of N users -> mmap load into 64 shards,
+    plus replaying a 1M record log tail
+
+ usage: ./persist-bench [dir] [users] [--drop-caches]
+   dir   scratch directory            (default /tmp/persist-bench)
+   users users in the snapshot        (default 10000000)
+   --drop-caches  before the load, write /proc/sys/vm/drop_caches so
+         the load is a real cold read. This empties the page cache of
+         the WHOLE machine (needs root). Off by default: without it the
+         cold start numbers are warm-cache.
+========================================
+*/
+
+void clear_dir(const string& dir) {
+    for (auto s : list_segments(dir, "wal-", ".log"))
+        unlink(wal_path(dir, s).c_str());
+    for (auto s : list_segments(dir, "snapshot-", ".bin"))
+        unlink(snapshot_path(dir, s).c_str());
+}
+
+double write_throughput(const string& dir, Durability mode, int window_ms,
+                        int threads, double secs) {
+    clear_dir(dir);
+    atomic<long long> ops{0};
+    {
+        Wal wal(dir, 1, mode, window_ms);
+        auto stop = chrono::steady_clock::now() + chrono::duration<double>(secs);
+        vector<thread> pool;
+        for (int t = 0; t < threads; t++)
+            pool.emplace_back([&, t] {
+                long long n = 0;
+                int id = t * 100000000;
+                while (chrono::steady_clock::now() < stop) {
+                    uint64_t lsn = wal.append(WAL_SET, ++id, "some user name");
+                    wal.wait_durable(lsn);
+                    n++;
+                }
+                ops += n;
+            });
+        for (auto& t : pool) t.join();
+    }
+    return ops / secs;
+}
+
+int main(int argc, char** argv) {
+    vector<string> args;
+    bool drop_caches = false;
+    for (int i = 1; i < argc; i++) {
+        if (string(argv[i]) == "--drop-caches") drop_caches = true;
+        else args.push_back(argv[i]);
+    }
+    string dir = args.size() > 0 ? args[0] : "/tmp/persist-bench";
+    int users = args.size() > 1 ? stoi(args[1]) : 10000000;
+    mkdir(dir.c_str(), 0755);
+
+    cout << fixed << setprecision(0);
+    cout << "== log writes (ops/sec)\n";
+    cout << setw(18) << "mode" << setw(12) << "1 thread"
+         << setw(12) << "4 threads" << setw(12) << "16 threads" << "\n";
+
+    struct Mode {
+        const char* name;
+        Durability d;
+        int window;
+    };
+    Mode modes[] = {
+        {"none", Durability::NONE, 10},
+        {"group 1ms", Durability::GROUP, 1},
+        {"group 10ms", Durability::GROUP, 10},
+        {"sync", Durability::SYNC, 10},
+    };
+    for (auto& m : modes) {
+        cout << setw(18) << m.name;
+        for (int t : {1, 4, 16})
+            cout << setw(12) << write_throughput(dir, m.d, m.window, t, 1.0);
+        cout << endl;
+    }
+
+    cout << setprecision(2);
+    cout << "== cold start, " << users << " users\n";
+    clear_dir(dir);
+
+    double written = timeIt([&] {
+        SnapshotWriter out(snapshot_path(dir, 1));
+        for (int id = 1; id <= users; id++)
+            out.add(id, "user" + to_string(id));
+        out.commit();
+    });
+    cout << "write snapshot      : " << written << " s\n";
+
+    const int LOG_TAIL = 1000000;
+    {
+        Wal wal(dir, 1, Durability::NONE, 10);
+        for (int i = 0; i < LOG_TAIL; i++)
+            wal.append(i % 4 ? WAL_SET : WAL_DELETE, i % users + 1, "renamed");
+    }
+
+    // --drop-caches: empty the page cache so this is a real cold read
+    bool cold = false;
+    if (drop_caches) {
+        sync();
+        if (FILE* f = fopen("/proc/sys/vm/drop_caches", "w")) {
+            cold = fputs("1", f) >= 0;
+            cold = fclose(f) == 0 && cold;
+        }
+        if (!cold) cout << "(could not drop caches, needs root)\n";
+    }
+
+    vector<UserStore> shards(64);
+    auto set = [&](int id, string_view name) {
+        UserStore& s = shards[(unsigned)(id - 1) % 64];
+        if (User* u = s.find(id)) u->name = name;
+        else s.insert(id, string(name));
+    };
+
+    int max_id = 0;
+    bool ok = false;
+    double load = timeIt([&] {
+        ok = load_snapshot(snapshot_path(dir, 1), set, max_id);
+    });
+
+    size_t replayed = 0;
+    double replay = timeIt([&] {
+        replayed = replay_wal(wal_path(dir, 1),
+                              [&](WalOp op, int id, string_view name) {
+            if (op == WAL_SET) set(id, name);
+            else shards[(unsigned)(id - 1) % 64].erase(id);
+        });
+    });
+
+    size_t live = 0;
+    for (auto& s : shards) live += s.size();
+    cout << "load snapshot (mmap): " << load << " s" << (ok ? "" : " FAILED")
+         << "\n";
+    cout << "replay " << replayed << " records: " << replay << " s\n";
+    cout << "cold start total    : " << load + replay << " s, "
+         << live << " users live" << (cold ? "" : " (warm page cache)") << "\n";
+
+    clear_dir(dir);
+    return 0;
+}
@@ -0,0 +1,392 @@
+#pragma once
+#include <bits/stdc++.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+========================================
+ PERSISTENCE: write-ahead log + snapshots
+----------------------------------------
+ files in the data directory:
+   wal-N.log       : append-only log segments, N counts up
+   snapshot-N.bin  : full store, taken right after wal-N.log was
+                     started, so recovery = snapshot-N + wal-N.. replay
+
+ WAL record:   u32 len | u32 fnv1a(payload) | payload
+ payload:      u8 op | i32 id | name bytes
+ A short or corrupt record ends the replay (torn tail after a crash).
+
+ Every op is an idempotent "final state" (create/update = set name,
+ delete = remove), so replaying records the snapshot already
+ contains is harmless.
+
+ durability modes (group commit: one background writer thread
+ takes everything appended so far in one write):
+   NONE  : write every window ms, never fsync
+   GROUP : write + fdatasync every window ms, callers never wait
+   SYNC  : a record counts once it is fdatasync'ed; the writer syncs
+           whatever piled up meanwhile in one go. Threads can block
+           in wait_durable, or (event loops) check durable_lsn()
+           from an on_durable callback.
+========================================
+*/
+
+enum class Durability { NONE, GROUP, SYNC };
+
+enum WalOp : uint8_t { WAL_SET = 1, WAL_DELETE = 2 };
+
+inline uint32_t fnv1a(const char* p, size_t n) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < n; i++) {
+        h ^= (unsigned char)p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+inline std::string wal_path(const std::string& dir, uint64_t seg) {
+    return dir + "/wal-" + std::to_string(seg) + ".log";
+}
+
+inline std::string snapshot_path(const std::string& dir, uint64_t seg) {
+    return dir + "/snapshot-" + std::to_string(seg) + ".bin";
+}
+
+// Segment numbers of "<prefix>N<suffix>" files in dir, sorted
+inline std::vector<uint64_t> list_segments(const std::string& dir,
+                                           const std::string& prefix,
+                                           const std::string& suffix) {
+    std::vector<uint64_t> segs;
+    DIR* d = opendir(dir.c_str());
+    if (!d) return segs;
+    while (dirent* e = readdir(d)) {
+        std::string name = e->d_name;
+        if (name.size() <= prefix.size() + suffix.size()) continue;
+        if (name.compare(0, prefix.size(), prefix) != 0) continue;
+        if (name.compare(name.size() - suffix.size(), suffix.size(),
+                         suffix) != 0)
+            continue;
+        std::string num = name.substr(prefix.size(), name.size() -
+                                      prefix.size() - suffix.size());
+        if (num.find_first_not_of("0123456789") != std::string::npos) continue;
+        segs.push_back(std::stoull(num));
+    }
+    closedir(d);
+    std::sort(segs.begin(), segs.end());
+    return segs;
+}
+
+class Wal {
+public:
+    Wal(std::string dir, uint64_t segment, Durability mode, int window_ms)
+        : dir(std::move(dir)), mode(mode), window(window_ms) {
+        open_segment(segment);
+        writer = std::thread([this] { run(); });
+    }
+
+    ~Wal() {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stopping = true;
+        }
+        wake.notify_all();
+        writer.join();
+        close(fd);
+    }
+
+    uint64_t segment() const { return seg; }
+
+    // Queue a record, returns its log sequence number
+    uint64_t append(WalOp op, int id, std::string_view name) {
+        uint32_t len = (uint32_t)(5 + name.size());
+        char head[13];
+        head[8] = (char)op;
+        memcpy(head + 9, &id, 4);
+        uint32_t sum = fnv1a(head + 8, 5);
+        // continue the hash over the name
+        for (unsigned char c : name) {
+            sum ^= c;
+            sum *= 16777619u;
+        }
+        memcpy(head, &len, 4);
+        memcpy(head + 4, &sum, 4);
+
+        std::lock_guard<std::mutex> lock(m);
+        pending.append(head, sizeof(head));
+        pending.append(name.data(), name.size());
+        appended++;
+        if (mode == Durability::SYNC) wake.notify_one();
+        return appended;
+    }
+
+    // SYNC mode: block until the record is on disk. No-op otherwise.
+    void wait_durable(uint64_t lsn) {
+        if (mode != Durability::SYNC) return;
+        std::unique_lock<std::mutex> lock(m);
+        done.wait(lock, [&] { return durable >= lsn || stopping; });
+    }
+
+    Durability durability() const { return mode; }
+
+    // every record up to this lsn is on disk (SYNC / GROUP)
+    uint64_t durable_lsn() {
+        std::lock_guard<std::mutex> lock(m);
+        return durable;
+    }
+
+    // f() runs on the writer thread after every commit; keep it short
+    // (e.g. wake an event loop) and do not call back into the Wal
+    void on_durable(std::function<void()> f) {
+        std::lock_guard<std::mutex> lock(m);
+        listeners.push_back(std::move(f));
+    }
+
+    uint64_t records() {
+        std::lock_guard<std::mutex> lock(m);
+        return appended;
+    }
+
+    // Flush the current segment and start the next. Returns the new number.
+    uint64_t rotate() {
+        std::unique_lock<std::mutex> lock(m);
+        done.wait(lock, [&] { return !writing; });   // batch in flight
+        write_all(fd, pending);
+        if (mode != Durability::NONE) fdatasync(fd);
+        durable = appended;
+        pending.clear();
+        close(fd);
+        open_segment(seg + 1);
+        done.notify_all();
+        for (auto& f : listeners) f();
+        return seg;
+    }
+
+private:
+    std::string dir;
+    Durability mode;
+    std::chrono::milliseconds window;
+
+    std::mutex m;
+    std::condition_variable wake;   // writer waits here
+    std::condition_variable done;   // SYNC callers wait here
+    std::string pending;
+    uint64_t appended = 0;
+    uint64_t durable = 0;
+    bool stopping = false;
+    bool writing = false;   // writer thread is outside the lock with a batch
+    std::vector<std::function<void()>> listeners;
+
+    int fd = -1;
+    uint64_t seg = 0;
+    std::thread writer;
+
+    void open_segment(uint64_t n) {
+        seg = n;
+        fd = ::open(wal_path(dir, n).c_str(),
+                    O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            perror("wal open");
+            exit(1);
+        }
+    }
+
+    static void write_all(int fd, const std::string& s) {
+        size_t off = 0;
+        while (off < s.size()) {
+            ssize_t n = write(fd, s.data() + off, s.size() - off);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                perror("wal write");
+                exit(1);
+            }
+            off += n;
+        }
+    }
+
+    // Group commit loop
+    void run() {
+        std::string batch;
+        std::unique_lock<std::mutex> lock(m);
+        while (true) {
+            if (mode == Durability::SYNC)
+                wake.wait(lock, [&] { return !pending.empty() || stopping; });
+            else
+                wake.wait_for(lock, window, [&] { return stopping; });
+
+            if (pending.empty()) {
+                if (stopping) return;
+                continue;
+            }
+
+            // take the whole batch, write it without holding the lock
+            batch.swap(pending);
+            uint64_t upto = appended;
+            int batch_fd = fd;
+            writing = true;
+            lock.unlock();
+
+            write_all(batch_fd, batch);
+            if (mode != Durability::NONE) fdatasync(batch_fd);
+            batch.clear();
+
+            lock.lock();
+            writing = false;
+            durable = std::max(durable, upto);
+            done.notify_all();
+            for (auto& f : listeners) f();
+        }
+    }
+};
+
+/*
+ Replay one WAL segment. apply(op, id, name) per record.
+ Returns the number of records read (stops at a torn tail).
+*/
+template <class F>
+size_t replay_wal(const std::string& path, F apply) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return 0;
+    struct stat st;
+    fstat(fd, &st);
+    size_t size = st.st_size;
+    if (size == 0) {
+        close(fd);
+        return 0;
+    }
+
+    char* p = (char*)mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) return 0;
+    madvise(p, size, MADV_SEQUENTIAL);
+
+    size_t off = 0, count = 0;
+    while (off + 13 <= size) {
+        uint32_t len, sum;
+        memcpy(&len, p + off, 4);
+        memcpy(&sum, p + off + 4, 4);
+        if (len < 5 || off + 8 + len > size) break;
+        if (fnv1a(p + off + 8, len) != sum) break;
+
+        int id;
+        memcpy(&id, p + off + 9, 4);
+        apply((WalOp)p[off + 8], id,
+              std::string_view(p + off + 13, len - 5));
+        off += 8 + len;
+        count++;
+    }
+    munmap(p, size);
+    return count;
+}
+
+/*
+ Snapshot file:
+   "USNAP001" | u64 count | i32 max_id | u32 0
+   count x ( i32 id | u32 len | name bytes )
+ Written to a .tmp file, fsync'ed, then renamed into place.
+*/
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(std::string path)
+        : path(std::move(path)), tmp(this->path + ".tmp") {
+        f = fopen(tmp.c_str(), "wb");
+        if (!f) {
+            perror("snapshot open");
+            exit(1);
+        }
+        setvbuf(f, nullptr, _IOFBF, 1 << 20);
+        write_header();
+    }
+
+    void add(int id, std::string_view name) {
+        uint32_t len = (uint32_t)name.size();
+        fwrite(&id, 4, 1, f);
+        fwrite(&len, 4, 1, f);
+        fwrite(name.data(), 1, name.size(), f);
+        count++;
+        max_id = std::max(max_id, id);
+    }
+
+    // ids up to `id` were handed out, even if deleted since
+    void reserve_ids(int id) { max_id = std::max(max_id, id); }
+
+    bool commit() {
+        fseek(f, 0, SEEK_SET);
+        write_header();
+        fflush(f);
+        bool ok = fsync(fileno(f)) == 0;
+        fclose(f);
+        f = nullptr;
+        return ok && rename(tmp.c_str(), path.c_str()) == 0;
+    }
+
+    ~SnapshotWriter() {
+        if (f) {
+            fclose(f);
+            unlink(tmp.c_str());
+        }
+    }
+
+private:
+    std::string path, tmp;
+    FILE* f = nullptr;
+    uint64_t count = 0;
+    int max_id = 0;
+
+    void write_header() {
+        uint32_t zero = 0;
+        fwrite("USNAP001", 1, 8, f);
+        fwrite(&count, 8, 1, f);
+        fwrite(&max_id, 4, 1, f);
+        fwrite(&zero, 4, 1, f);
+    }
+};
+
+/*
+ mmap a snapshot and call add(id, name) for every user.
+ Returns false if the file is missing or damaged.
+*/
+template <class F>
+bool load_snapshot(const std::string& path, F add, int& max_id) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    struct stat st;
+    fstat(fd, &st);
+    size_t size = st.st_size;
+    if (size < 24) {
+        close(fd);
+        return false;
+    }
+
+    char* p = (char*)mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) return false;
+    madvise(p, size, MADV_SEQUENTIAL);
+
+    bool ok = memcmp(p, "USNAP001", 8) == 0;
+    uint64_t count = 0;
+    memcpy(&count, p + 8, 8);
+    memcpy(&max_id, p + 16, 4);
+
+    size_t off = 24;
+    for (uint64_t i = 0; ok && i < count; i++) {
+        if (off + 8 > size) {
+            ok = false;
+            break;
+        }
+        int id;
+        uint32_t len;
+        memcpy(&id, p + off, 4);
+        memcpy(&len, p + off + 4, 4);
+        if (off + 8 + len > size) {
+            ok = false;
+            break;
+        }
+        add(id, std::string_view(p + off + 8, len));
+        off += 8 + len;
+    }
+    munmap(p, size);
+    return ok;
+}
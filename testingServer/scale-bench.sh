@@ -0,0 +1,29 @@
+#!/bin/sh
+# Scaling benchmark: runs test-server with 1..32 worker threads and
+# drives it with load-gen. Build both first:
+#   g++ -O2 -pthread test-server.cpp -o test-server
+#   g++ -O2 -pthread load-gen.cpp -o load-gen
+#
+# usage: ./scale-bench.sh [port] [seconds] [path] [method]
+
+cd "$(dirname "$0")"
+PORT=${1:-8090}
+SECS=${2:-5}
+URL=${3:-/users?id=1}
+METHOD=${4:-GET}
+
+for T in 1 2 4 8 16 32; do
+    ./test-server "$PORT" "$T" > /dev/null &
+    SERVER=$!
+    sleep 0.3
+
+    # a few users so GET / PUT have something to hit
+    ./load-gen -P "$PORT" -c 4 -d 1 -X POST -u "/users?name=seed" > /dev/null
+
+    echo "== server threads: $T"
+    ./load-gen -P "$PORT" -t "$T" -c $((T * 32)) -d "$SECS" \
+               -X "$METHOD" -u "$URL"
+
+    kill "$SERVER"
+    wait "$SERVER" 2> /dev/null || true
+done
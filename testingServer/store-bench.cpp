@@ -0,0 +1,158 @@
+#include <bits/stdc++.h>
+#include "../bench.h"
+
+#include "user-store.h"
+
+using namespace std;
+
+/*
+========================================
+ STORE MICROBENCHMARK
+----------------------------------------
+ old : vector<User> + linear scans, remove_if + erase on delete
+ new : UserStore (slab + free list + open addressing index)
+
+ usage: ./store-bench [max_users]     (default 10000000)
+ sizes 10^3 .. max_users, prints ns per operation
+========================================
+*/
+
+// The original test-server store, kept as the baseline
+struct VectorStore {
+    vector<User> users;
+
+    User* find(int id) {
+        for (auto& u : users)
+            if (u.id == id) return &u;
+        return nullptr;
+    }
+
+    bool erase(int id) {
+        auto it = remove_if(users.begin(), users.end(),
+                            [&](auto& u){ return u.id == id; });
+        if (it == users.end()) return false;
+        users.erase(it, users.end());
+        return true;
+    }
+};
+
+// f(i) for i in [0, ops), ns per call
+template <class F>
+double ns_per_op(int ops, F f) {
+    return nsPer(ops, [&] {
+        for (int i = 0; i < ops; i++) f(i);
+    });
+}
+
+void run(int n) {
+    mt19937 rng(n);
+    long long sink = 0;
+    vector<int> ids(4096);
+    for (auto& id : ids) id = rng() % n + 1;
+
+    // the vector costs O(n) per op, keep its total work bounded
+    int slow_ops = max(10, min(4096, 200000000 / n));
+    int fast_ops = 1 << 20;
+
+    double old_get, old_upd, old_del, old_scan;
+    double new_get, new_upd, new_del, new_scan;
+
+    {
+        VectorStore vs;
+        vs.users.reserve(n);
+        for (int i = 1; i <= n; i++) vs.users.push_back({i, "user"});
+
+        old_get = ns_per_op(slow_ops, [&](int i){
+            sink += vs.find(ids[i & 4095])->id;
+        });
+        old_upd = ns_per_op(slow_ops, [&](int i){
+            vs.find(ids[i & 4095])->name = "renamed";
+        });
+        old_scan = ns_per_op(1, [&](int){
+            long long sum = 0;
+            for (auto& u : vs.users) sum += u.id;
+            sink += sum;
+        }) / n;
+        // delete + put back, so the size stays n
+        int del_ops = max(2, slow_ops / 8);
+        old_del = ns_per_op(del_ops, [&](int i){
+            int id = ids[i & 4095];
+            if (vs.erase(id)) vs.users.push_back({id, "user"});
+        });
+    }
+
+    {
+        UserStore us;
+        for (int i = 1; i <= n; i++) us.insert(i, "user");
+
+        new_get = ns_per_op(fast_ops, [&](int i){
+            sink += us.find(ids[i & 4095])->id;
+        });
+        new_upd = ns_per_op(fast_ops, [&](int i){
+            us.find(ids[i & 4095])->name = "renamed";
+        });
+        new_scan = ns_per_op(1, [&](int){
+            long long sum = 0;
+            us.for_each([&](const User& u){ sum += u.id; });
+            sink += sum;
+        }) / n;
+        new_del = ns_per_op(fast_ops, [&](int i){
+            int id = ids[i & 4095];
+            if (us.erase(id)) us.insert(id, "user");
+        });
+    }
+
+    cout << setw(9) << n << " | "
+         << setw(10) << old_get << setw(10) << new_get << " | "
+         << setw(10) << old_upd << setw(10) << new_upd << " | "
+         << setw(12) << old_del << setw(10) << new_del << " | "
+         << setw(6) << old_scan << setw(6) << new_scan << "\n";
+    keep(sink);
+}
+
+// Random ops against std::unordered_map, so the numbers mean something
+bool self_check() {
+    UserStore us;
+    unordered_map<int, string> ref;
+    mt19937 rng(7);
+    for (int i = 0; i < 200000; i++) {
+        int id = rng() % 5000 + 1;
+        switch (rng() % 3) {
+        case 0:
+            if (us.insert(id, to_string(i)) != !ref.count(id)) return false;
+            ref.emplace(id, to_string(i));
+            break;
+        case 1:
+            if (us.erase(id) != (ref.erase(id) == 1)) return false;
+            break;
+        default: {
+            User* u = us.find(id);
+            auto it = ref.find(id);
+            if ((u == nullptr) != (it == ref.end())) return false;
+            if (u && u->name != it->second) return false;
+        }
+        }
+    }
+    size_t live = 0;
+    us.for_each([&](const User&){ live++; });
+    return live == ref.size() && us.size() == ref.size();
+}
+
+int main(int argc, char** argv) {
+    int max_users = argc > 1 ? atoi(argv[1]) : 10000000;
+
+    if (!self_check()) {
+        cout << "UserStore self check FAILED\n";
+        return 1;
+    }
+
+    cout << fixed << setprecision(1);
+    cout << "ns per op (old = vector, new = UserStore)\n";
+    cout << setw(9) << "users" << " | "
+         << setw(10) << "get old" << setw(10) << "new" << " | "
+         << setw(10) << "update old" << setw(10) << "new" << " | "
+         << setw(12) << "delete old" << setw(10) << "new" << " | "
+         << setw(6) << "scan" << setw(6) << "new" << "\n";
+    for (long long n = 1000; n <= max_users; n *= 10) run((int)n);
+    return 0;
+}
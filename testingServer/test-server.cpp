@@ -1,137 +1,884 @@
 #include <bits/stdc++.h>
+#include <fcntl.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <unistd.h>
 
+#include "http-parser.h"
+#include "metrics.h"
+#include "out-queue.h"
+#include "persistence.h"
+#include "user-store.h"
+
 using namespace std;
 
-struct User {
-    int id;
-    string name;
+/*
+ Partitioned user store:
+ - SHARDS independent shards, each with its own lock
+ - a user lives in shard (id - 1) % SHARDS, so lookups go straight to it
+ - ids come from one relaxed atomic counter: consecutive creates land
+   in different shards, so writers rarely meet on the same lock
+*/
+const int SHARDS = 64;
+
+struct alignas(64) Shard {
+    mutex m;
+    UserStore users;
 };
 
-vector<User> users;
-int next_id = 1;
+Shard shards[SHARDS];
+atomic<int> next_id{1};
 
-/* ---------- Utilities ---------- */
+Shard& shard_of(int id) {
+    return shards[(unsigned)(id - 1) % SHARDS];
+}
+
+/* ---------- Persistence ---------- */
 
-string http_response(const string& body) {
-    return "HTTP/1.1 200 OK\r\n"
-           "Content-Type: text/plain\r\n"
-           "Content-Length: " + to_string(body.size()) + "\r\n\r\n" +
-           body;
+/*
+ Off unless started with -D <dir>. Every change is logged while its
+ shard lock is held, so the log has each user's changes in the order
+ they were applied. In SYNC mode the reply is held back (see
+ hold_reply) until the group commit reaches the disk; the worker
+ thread keeps serving other connections meanwhile.
+*/
+unique_ptr<Wal> wal;
+
+uint64_t log_set(int id, string_view name) {
+    return wal ? wal->append(WAL_SET, id, name) : 0;
+}
+
+uint64_t log_delete(int id) {
+    return wal ? wal->append(WAL_DELETE, id, {}) : 0;
 }
 
-map<string,string> parse_query(const string& s) {
-    map<string,string> q;
-    size_t pos = s.find('?');
-    if (pos == string::npos) return q;
+// lsn the reply being built has to wait for (0 = none), per worker
+thread_local uint64_t reply_lsn = 0;
+
+void hold_reply(uint64_t lsn) {
+    if (wal && wal->durability() == Durability::SYNC)
+        reply_lsn = max(reply_lsn, lsn);
+}
 
-    string query = s.substr(pos + 1);
-    stringstream ss(query);
-    string pair;
+// Load the newest good snapshot, replay the log after it.
+// Returns the segment number the new log should use.
+uint64_t recover(const string& dir) {
+    int max_id = 0;
+    auto set = [&](int id, string_view name) {
+        Shard& sh = shard_of(id);
+        if (User* u = sh.users.find(id)) u->name = name;
+        else sh.users.insert(id, string(name));
+        max_id = max(max_id, id);
+    };
 
-    while (getline(ss, pair, '&')) {
-        auto eq = pair.find('=');
-        if (eq != string::npos)
-            q[pair.substr(0, eq)] = pair.substr(eq + 1);
+    uint64_t from = 0;
+    auto snaps = list_segments(dir, "snapshot-", ".bin");
+    for (auto it = snaps.rbegin(); it != snaps.rend(); ++it) {
+        if (load_snapshot(snapshot_path(dir, *it), set, max_id)) {
+            from = *it;
+            break;
+        }
+        cerr << "skipping damaged " << snapshot_path(dir, *it) << "\n";
+        for (auto& sh : shards) sh.users = UserStore();
+        max_id = 0;
+    }
+
+    uint64_t last = from;
+    size_t replayed = 0;
+    for (uint64_t seg : list_segments(dir, "wal-", ".log")) {
+        if (seg < from) continue;
+        replayed += replay_wal(wal_path(dir, seg),
+                               [&](WalOp op, int id, string_view name) {
+            if (op == WAL_SET) set(id, name);
+            else if (op == WAL_DELETE) shard_of(id).users.erase(id);
+            max_id = max(max_id, id);
+        });
+        last = max(last, seg);
     }
-    return q;
+
+    next_id = max_id + 1;
+    cout << "Recovered from " << dir << ": snapshot " << from
+         << ", " << replayed << " log records\n";
+    return last + 1;
+}
+
+/*
+ Snapshot: start a new log segment first, then copy the shards one
+ at a time. Anything changed while copying is also in the new
+ segment, and replaying it over the snapshot is harmless.
+*/
+void take_snapshot(const string& dir) {
+    uint64_t seg = wal->rotate();
+    int top = next_id.load() - 1;
+
+    SnapshotWriter out(snapshot_path(dir, seg));
+    vector<User> copy;
+    for (auto& sh : shards) {
+        copy.clear();
+        {
+            lock_guard<mutex> lock(sh.m);
+            sh.users.for_each([&](const User& u){ copy.push_back(u); });
+        }
+        for (auto& u : copy) out.add(u.id, u.name);
+    }
+    out.reserve_ids(top);
+    if (!out.commit()) {
+        perror("snapshot");
+        return;
+    }
+
+    // older files are covered by the new snapshot
+    for (uint64_t s : list_segments(dir, "wal-", ".log"))
+        if (s < seg) unlink(wal_path(dir, s).c_str());
+    for (uint64_t s : list_segments(dir, "snapshot-", ".bin"))
+        if (s < seg) unlink(snapshot_path(dir, s).c_str());
+}
+
+void snapshot_loop(string dir, int every_secs) {
+    uint64_t seen = 0;
+    while (true) {
+        this_thread::sleep_for(chrono::seconds(every_secs));
+        uint64_t now = wal->records();
+        if (now == seen) continue;   // nothing changed
+        seen = now;
+        take_snapshot(dir);
+    }
+}
+
+/* ---------- Utilities ---------- */
+
+// Status line + headers + body straight into the output blocks
+void write_response(OutQueue& out, string_view body, bool keep_alive) {
+    char len[24];
+    auto r = to_chars(len, len + sizeof(len), body.size());
+
+    out.append("HTTP/1.1 200 OK\r\n"
+               "Content-Type: text/plain\r\n"
+               "Content-Length: ");
+    out.append(len, r.ptr - len);
+    out.append(keep_alive ? "\r\n\r\n" : "\r\nConnection: close\r\n\r\n");
+    out.append(body);
+}
+
+const string_view BAD_REQUEST = "HTTP/1.1 400 Bad Request\r\n"
+                                "Content-Type: text/plain\r\n"
+                                "Content-Length: 11\r\n"
+                                "Connection: close\r\n\r\n"
+                                "Bad request";
+
+optional<int> parse_int(optional<string_view> s) {
+    if (!s) return nullopt;
+    int v = 0;
+    auto r = from_chars(s->data(), s->data() + s->size(), v);
+    if (r.ec != errc() || r.ptr != s->data() + s->size()) return nullopt;
+    return v;
 }
 
 /* ---------- CRUD Handlers ---------- */
 
-string create_user(const map<string,string>& q) {
-    auto it = q.find("name");
-    if (it == q.end()) return "Missing name";
+string create_user(const HttpRequest& r) {
+    auto name = r.param("name");
+    if (!name) return "Missing name";
 
-    users.push_back({next_id++, it->second});
+    int id = next_id.fetch_add(1, memory_order_relaxed);
+    Shard& sh = shard_of(id);
+    uint64_t lsn;
+    {
+        lock_guard<mutex> lock(sh.m);
+        sh.users.insert(id, string(*name));
+        lsn = log_set(id, *name);
+    }
+    hold_reply(lsn);
     return "User created";
 }
 
-string list_users() {
-    string out;
-    for (auto& u : users)
-        out += to_string(u.id) + " " + u.name + "\n";
-    return out.empty() ? "No users" : out;
+/*
+ GET /users streams the listing with chunked encoding:
+ - walks ids in order from the cursor, one shard lookup per id
+ - each turn fills at most STREAM_BLOCKS output blocks, then the
+   socket has to take them before more is produced, so memory per
+   listing stays fixed and the first bytes leave right away
+ - each turn also looks at most STREAM_SCAN ids, so sparse or mostly
+   deleted ids (or a large offset) never hold up the event loop; the
+   listing then waits for the worker's next turn
+ - ?cursor=ID starts after ID, ?offset=N skips N users,
+   ?limit=N stops after N users (the last id listed is the next cursor)
+*/
+const size_t STREAM_BLOCKS = 4;
+const int STREAM_SCAN = 4096;
+
+struct ListStream {
+    bool active = false;
+    int pos = 1;          // next id to look at
+    int end = 1;          // ids at or past this did not exist at the start
+    long long skip = 0;
+    long long left = -1;  // -1 = no limit
+    bool any = false;
+};
+
+// Produce the next part of the listing into out.
+// false -> STREAM_SCAN ids looked at, resume on a later turn
+bool stream_users(ListStream& ls, OutQueue& out) {
+    char num[16];
+    for (int scanned = 0; out.block_count() < STREAM_BLOCKS; scanned++) {
+        if (ls.pos >= ls.end || ls.left == 0) {
+            if (!ls.any) out.chunk_write("No users");
+            out.end_chunked();
+            ls.active = false;
+            return true;
+        }
+        if (scanned == STREAM_SCAN) return false;
+
+        int id = ls.pos++;
+        Shard& sh = shard_of(id);
+        lock_guard<mutex> lock(sh.m);
+        User* u = sh.users.find(id);
+        if (!u) continue;
+        if (ls.skip > 0) {
+            ls.skip--;
+            continue;
+        }
+
+        auto r = to_chars(num, num + sizeof(num), id);
+        *r.ptr++ = ' ';
+        out.chunk_write(num, r.ptr - num);
+        out.chunk_write(u->name);
+        out.chunk_write("\n");
+        if (ls.left > 0) ls.left--;
+        ls.any = true;
+    }
+    return true;
+}
+
+bool list_users(ListStream& ls, OutQueue& out, const HttpRequest& r) {
+    auto cursor = parse_int(r.param("cursor"));
+    auto offset = parse_int(r.param("offset"));
+    auto limit = parse_int(r.param("limit"));
+    if ((r.param("cursor") && !cursor) || (r.param("offset") && !offset) ||
+        (r.param("limit") && !limit))
+        return false;
+
+    ls = ListStream();
+    ls.active = true;
+    ls.pos = max(1, cursor.value_or(0) + 1);
+    ls.end = next_id.load(memory_order_relaxed);
+    ls.skip = max(0, offset.value_or(0));
+    ls.left = limit ? max(0, *limit) : -1;
+
+    out.append(r.keep_alive ? "HTTP/1.1 200 OK\r\n"
+                              "Content-Type: text/plain\r\n"
+                              "Transfer-Encoding: chunked\r\n\r\n"
+                            : "HTTP/1.1 200 OK\r\n"
+                              "Content-Type: text/plain\r\n"
+                              "Transfer-Encoding: chunked\r\n"
+                              "Connection: close\r\n\r\n");
+    return true;
 }
 
 string get_user(int id) {
-    for (auto& u : users)
-        if (u.id == id)
-            return to_string(u.id) + " " + u.name;
-    return "User not found";
+    Shard& sh = shard_of(id);
+    lock_guard<mutex> lock(sh.m);
+    User* u = sh.users.find(id);
+    if (!u) return "User not found";
+    return to_string(u->id) + " " + u->name;
 }
 
-string update_user(int id, const map<string,string>& q) {
-    auto it = q.find("name");
-    if (it == q.end()) return "Missing name";
+string update_user(int id, const HttpRequest& r) {
+    auto name = r.param("name");
+    if (!name) return "Missing name";
 
-    for (auto& u : users)
-        if (u.id == id) {
-            u.name = it->second;
-            return "User updated";
-        }
-    return "User not found";
+    Shard& sh = shard_of(id);
+    uint64_t lsn;
+    {
+        lock_guard<mutex> lock(sh.m);
+        User* u = sh.users.find(id);
+        if (!u) return "User not found";
+        u->name = *name;
+        lsn = log_set(id, *name);
+    }
+    hold_reply(lsn);
+    return "User updated";
 }
 
 string delete_user(int id) {
-    auto it = remove_if(users.begin(), users.end(),
-                        [&](auto& u){ return u.id == id; });
-    if (it == users.end()) return "User not found";
-
-    users.erase(it, users.end());
+    Shard& sh = shard_of(id);
+    uint64_t lsn;
+    {
+        lock_guard<mutex> lock(sh.m);
+        if (!sh.users.erase(id)) return "User not found";
+        lsn = log_delete(id);
+    }
+    hold_reply(lsn);
     return "User deleted";
 }
 
+/* ---------- Batch Handler ---------- */
+
+/*
+ POST /users/batch, body = one op per line:
+   C <name>        create       -> "<new id>"
+   U <id> <name>   update       -> "updated" | "not found"
+   D <id>          delete       -> "deleted" | "not found"
+   G <id>          lookup       -> "<id> <name>" | "not found"
+ Response has one line per op, same order; bad lines get "error".
+
+ Applied in one pass: ids for all creates are reserved with one
+ atomic add, ops are bucketed by shard (stable, so ops on one user
+ keep their order) and every shard lock is taken once. In SYNC
+ mode the reply waits for one fsync, not one per op.
+*/
+struct BatchOp {
+    char kind;
+    int id;
+    string_view name;
+};
+
+string batch_users(string_view body) {
+    vector<BatchOp> ops;
+    while (!body.empty()) {
+        size_t nl = body.find('\n');
+        string_view line = body.substr(0, nl);
+        body = nl == string_view::npos ? string_view() : body.substr(nl + 1);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (line.empty()) continue;
+
+        BatchOp op{line[0], 0, {}};
+        string_view rest = line.size() > 2 && line[1] == ' ' ? line.substr(2)
+                                                             : string_view();
+        if (op.kind == 'C') {
+            op.name = rest;
+            if (rest.empty()) op.kind = 'E';
+        } else {
+            size_t sp = rest.find(' ');
+            auto id = parse_int(rest.substr(0, sp));
+            if (!id) op.kind = 'E';
+            else op.id = *id;
+            if (op.kind == 'U') {
+                if (sp == string_view::npos) op.kind = 'E';
+                else op.name = rest.substr(sp + 1);
+            } else if (op.kind != 'D' && op.kind != 'G') {
+                op.kind = 'E';
+            }
+        }
+        ops.push_back(op);
+    }
+
+    int creates = 0;
+    for (auto& op : ops) creates += op.kind == 'C';
+    int first = next_id.fetch_add(creates, memory_order_relaxed);
+    for (auto& op : ops)
+        if (op.kind == 'C') op.id = first++;
+
+    // counting sort of op indexes by shard
+    vector<int> start(SHARDS + 1), order(ops.size());
+    for (auto& op : ops)
+        if (op.kind != 'E') start[(unsigned)(op.id - 1) % SHARDS + 1]++;
+    for (int i = 0; i < SHARDS; i++) start[i + 1] += start[i];
+    vector<int> fill(start.begin(), start.end() - 1);
+    for (int i = 0; i < (int)ops.size(); i++)
+        if (ops[i].kind != 'E')
+            order[fill[(unsigned)(ops[i].id - 1) % SHARDS]++] = i;
+
+    vector<string> results(ops.size(), "error");
+    uint64_t lsn = 0;
+    for (int s = 0; s < SHARDS; s++) {
+        if (start[s] == start[s + 1]) continue;
+        Shard& sh = shards[s];
+        lock_guard<mutex> lock(sh.m);
+        for (int k = start[s]; k < start[s + 1]; k++) {
+            BatchOp& op = ops[order[k]];
+            string& res = results[order[k]];
+            if (op.kind == 'C') {
+                sh.users.insert(op.id, string(op.name));
+                lsn = max(lsn, log_set(op.id, op.name));
+                res = to_string(op.id);
+            } else if (op.kind == 'G') {
+                User* u = sh.users.find(op.id);
+                res = u ? to_string(u->id) + " " + u->name : "not found";
+            } else if (op.kind == 'U') {
+                User* u = sh.users.find(op.id);
+                if (u) {
+                    u->name = op.name;
+                    lsn = max(lsn, log_set(op.id, op.name));
+                }
+                res = u ? "updated" : "not found";
+            } else {
+                bool found = sh.users.erase(op.id);
+                if (found) lsn = max(lsn, log_delete(op.id));
+                res = found ? "deleted" : "not found";
+            }
+        }
+    }
+    hold_reply(lsn);
+
+    string out;
+    for (auto& res : results) {
+        out += res;
+        out += '\n';
+    }
+    return out;
+}
+
+/* ---------- Routing ---------- */
+
+Route route_of(const HttpRequest& r) {
+    if (r.path == "/metrics") return ROUTE_METRICS;
+    if (r.path == "/users/batch")
+        return r.method == "POST" ? ROUTE_BATCH : ROUTE_BAD_REQUEST;
+    if (r.path.substr(0, 6) != "/users") return ROUTE_NOT_FOUND;
+    if (r.method == "POST") return ROUTE_CREATE;
+    if (r.method == "GET") return r.param("id") ? ROUTE_GET : ROUTE_LIST;
+    if (r.method == "PUT") return ROUTE_UPDATE;
+    if (r.method == "DELETE") return ROUTE_DELETE;
+    return ROUTE_BAD_REQUEST;
+}
+
+// Every route but ROUTE_LIST, which streams (see list_users)
+string handle_request(const HttpRequest& r, Route route) {
+    auto id = parse_int(r.param("id"));
+
+    switch (route) {
+    case ROUTE_METRICS:
+        return metrics_text();
+    case ROUTE_CREATE:
+        return create_user(r);
+    case ROUTE_GET:
+        return id ? get_user(*id) : "Bad request";
+    case ROUTE_UPDATE:
+        return id ? update_user(*id, r) : "Bad request";
+    case ROUTE_DELETE:
+        return id ? delete_user(*id) : "Bad request";
+    case ROUTE_BATCH:
+        return batch_users(r.body);
+    case ROUTE_NOT_FOUND:
+        return "Not found";
+    default:
+        return "Unsupported method";
+    }
+}
+
+/* ---------- Connections ---------- */
+
+/*
+ Reusable input buffer, live bytes are data[begin, end).
+ - read() writes straight into the free tail
+ - consuming a request only moves begin
+ - live bytes slide back to the front only when the tail is full,
+   the buffer grows only when one request does not fit
+*/
+struct Buffer {
+    vector<char> data;
+    size_t begin = 0;
+    size_t end = 0;
+
+    char* start() { return data.data() + begin; }
+    size_t size() const { return end - begin; }
+
+    void consume(size_t n) {
+        begin += n;
+        if (begin == end) begin = end = 0;
+    }
+
+    // make room for at least `want` bytes after end
+    void reserve_tail(size_t want) {
+        if (data.size() - end >= want) return;
+        if (begin > 0) {
+            memmove(data.data(), data.data() + begin, size());
+            end -= begin;
+            begin = 0;
+        }
+        if (data.size() - end < want)
+            data.resize(max(data.size() * 2, end + want));
+    }
+};
+
+/*
+ One Conn per client socket.
+ - in     : bytes read but not yet handled (may hold pipelined requests)
+ - parser : progress through the request at the front of in
+ - out    : responses not yet written
+ - stream : a GET /users listing still being produced; later
+            pipelined requests wait until it is done
+ - held   : SYNC mode reply whose log records are not on disk yet;
+            later pipelined requests wait behind it too
+ - ready  : listing used up its scan budget and sits in ready_conns
+ - unread : reading stopped behind a stream or held reply, the socket
+            may still have bytes (edge triggered: no new EPOLLIN)
+ - eof    : peer half-closed, in holds everything it will send
+*/
+struct HeldReply {
+    uint64_t lsn = 0;   // 0 = nothing held
+    string body;
+    bool keep_alive = true;
+};
+
+struct Conn {
+    int fd = -1;
+    Buffer in;
+    HttpParser parser;
+    OutQueue out;
+    ListStream stream;
+    HeldReply held;
+    bool ready = false;
+    bool unread = false;
+    bool eof = false;
+    bool closing = false;   // close once out is flushed
+};
+
+// fds of this worker's connections with a held reply
+thread_local vector<int> held_conns;
+// fds of this worker's listings to resume after the next epoll_wait
+thread_local vector<int> ready_conns;
+
+/*
+ One Worker per thread: its own SO_REUSEPORT listener, epoll instance
+ and connection table. The kernel spreads new connections across the
+ listeners, so workers never share sockets.
+*/
+struct Worker {
+    int index = 0;
+    int listen_fd = -1;
+    int epfd = -1;
+    int wake_fd = -1;   // eventfd, SYNC mode only
+    unordered_map<int, Conn> conns;
+};
+
+void set_nonblocking(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+// Handle every complete request sitting in c.in and queue the responses.
+void process_requests(Conn& c) {
+    ThreadMetrics* m = metrics_on ? thread_metrics : nullptr;
+
+    while (!c.closing && !c.stream.active && !c.held.lsn && c.in.size() > 0) {
+        bool timed = m && m->sample();
+        uint64_t t0 = timed ? now_ns() : 0;
+        auto status = c.parser.parse(c.in.start(), c.in.size());
+        if (status == HttpParser::NEED_MORE) break;
+        if (status == HttpParser::ERROR) {
+            if (m) m->requests[ROUTE_BAD_REQUEST].add(1);
+            c.out.append(BAD_REQUEST);
+            c.closing = true;
+            break;
+        }
+
+        const HttpRequest& r = c.parser.request();
+        uint64_t t1 = timed ? now_ns() : 0;
+        Route route = route_of(r);
+        reply_lsn = 0;
+        if (route != ROUTE_LIST) {
+            string body = handle_request(r, route);
+            if (reply_lsn && reply_lsn > wal->durable_lsn()) {
+                c.held = {reply_lsn, move(body), r.keep_alive};
+                held_conns.push_back(c.fd);
+            } else {
+                write_response(c.out, body, r.keep_alive);
+            }
+        } else if (!list_users(c.stream, c.out, r))
+            write_response(c.out, "Bad request", r.keep_alive);
+        if (!r.keep_alive) c.closing = true;
+
+        if (m) m->requests[route].add(1);
+        if (timed) {
+            m->latency[PHASE_PARSE].record(t1 - t0);
+            m->latency[PHASE_HANDLER].record(now_ns() - t1);
+        }
+
+        c.in.consume(c.parser.consumed());
+        c.parser.reset();
+    }
+}
+
+/*
+ Drain the socket (edge triggered: read until EAGAIN), handling
+ requests after every read so the buffer only ever has to hold
+ one partial request. Reading stops while a listing or a held reply
+ blocks the requests behind it (pump resumes it), so a pipelining
+ client cannot grow in without bound. false -> connection is broken.
+*/
+bool read_input(Conn& c) {
+    c.unread = false;
+    while (!c.eof && !c.closing) {
+        if (c.stream.active || c.held.lsn) {
+            c.unread = true;
+            return true;
+        }
+        c.in.reserve_tail(4096);
+        ssize_t n = read(c.fd, c.in.data.data() + c.in.end,
+                         c.in.data.size() - c.in.end);
+        if (n > 0) {
+            c.in.end += n;
+            if (metrics_on) thread_metrics->bytes_in.add(n);
+            process_requests(c);
+            continue;
+        }
+        if (n == 0) {   // peer half-closed: still answer what it sent
+            c.eof = true;
+            return true;
+        }
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) return true;
+        return false;
+    }
+    return true;
+}
+
+/*
+ Push output forward: flush, keep a running listing topped up,
+ then pick up requests that were waiting behind it.
+ false -> close the connection.
+*/
+bool pump(Conn& c) {
+    ThreadMetrics* m = metrics_on ? thread_metrics : nullptr;
+
+    while (true) {
+        if (!c.out.empty() && m) {
+            size_t written = 0;
+            bool timed = m->sample();
+            uint64_t t0 = timed ? now_ns() : 0;
+            bool ok = c.out.flush(c.fd, &written);
+            if (timed) m->latency[PHASE_WRITE].record(now_ns() - t0);
+            m->bytes_out.add(written);
+            if (!ok) return false;
+        } else if (!c.out.flush(c.fd)) {
+            return false;
+        }
+        if (!c.out.empty()) return true;   // socket full, wait for EPOLLOUT
+
+        if (c.stream.active) {
+            if (stream_users(c.stream, c.out) || !c.out.empty()) continue;
+            if (!c.ready) {
+                c.ready = true;
+                ready_conns.push_back(c.fd);
+            }
+            return true;
+        }
+        if (c.held.lsn) return true;   // release_held picks it up
+        if (c.closing) return false;
+
+        process_requests(c);
+        if (!c.out.empty() || c.stream.active || c.held.lsn) continue;
+        if (c.unread) {   // read what arrived while requests were waiting
+            if (!read_input(c)) return false;
+            continue;
+        }
+        return !c.eof;   // half-closed and every request answered
+    }
+}
+
+void close_conn(Worker& w, int fd) {
+    epoll_ctl(w.epfd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    w.conns.erase(fd);
+    if (metrics_on) thread_metrics->conns_closed.add(1);
+}
+
+// Send every held reply whose records are on disk now, then carry on
+// with whatever the connection had pipelined behind it.
+void release_held(Worker& w) {
+    uint64_t durable = wal->durable_lsn();
+    vector<int> waiting;
+    waiting.swap(held_conns);
+    for (int fd : waiting) {
+        auto found = w.conns.find(fd);
+        if (found == w.conns.end() || !found->second.held.lsn) continue;   // closed
+        Conn& c = found->second;
+        if (c.held.lsn > durable) {
+            held_conns.push_back(fd);
+            continue;
+        }
+        write_response(c.out, c.held.body, c.held.keep_alive);
+        c.held = HeldReply();
+        if (!pump(c)) close_conn(w, fd);
+    }
+}
+
+// Give every listing that ran out of scan budget its next turn
+void resume_ready(Worker& w) {
+    vector<int> ready;
+    ready.swap(ready_conns);
+    for (int fd : ready) {
+        auto found = w.conns.find(fd);
+        if (found == w.conns.end() || !found->second.ready) continue;   // closed
+        Conn& c = found->second;
+        c.ready = false;
+        if (!pump(c)) close_conn(w, fd);
+    }
+}
+
 /* ---------- Main Server ---------- */
 
-int main() {
-    int server_fd = socket(AF_INET, SOCK_STREAM, 0);
+int open_listener(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
 
     sockaddr_in addr{};
     addr.sin_family = AF_INET;
-    addr.sin_port = htons(8080);
+    addr.sin_port = htons(port);
     addr.sin_addr.s_addr = INADDR_ANY;
 
-    bind(server_fd, (sockaddr*)&addr, sizeof(addr));
-    listen(server_fd, 10);
+    if (bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+        perror("bind");
+        exit(1);
+    }
+    listen(fd, SOMAXCONN);
+    set_nonblocking(fd);
+    return fd;
+}
+
+/*
+ Event loop (one per worker):
+ - listener and clients are non-blocking, registered edge triggered
+ - SYNC mode: the log writer signals wake_fd after every commit, and
+   held replies that are now durable go out (release_held)
+ - listings that used up their scan budget are resumed after each
+   batch of events; epoll_wait does not block while any are waiting
+ - every client is watched for both EPOLLIN and EPOLLOUT once,
+   so a slow client never blocks the others
+ - keep-alive + pipelining: each read may hold 0..n requests,
+   all answered in order
+*/
+void run_worker(Worker& w) {
+    metrics_register_thread();
+    int one = 1;
+
+    w.epfd = epoll_create1(0);
+    epoll_event ev{};
+    ev.events = EPOLLIN | EPOLLET;
+    ev.data.fd = w.listen_fd;
+    epoll_ctl(w.epfd, EPOLL_CTL_ADD, w.listen_fd, &ev);
 
-    cout << "Server running on port 8080\n";
+    if (wal && wal->durability() == Durability::SYNC) {
+        w.wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        ev.events = EPOLLIN | EPOLLET;
+        ev.data.fd = w.wake_fd;
+        epoll_ctl(w.epfd, EPOLL_CTL_ADD, w.wake_fd, &ev);
+        int wake_fd = w.wake_fd;
+        wal->on_durable([wake_fd] {
+            uint64_t one = 1;
+            if (write(wake_fd, &one, sizeof(one)) < 0) {}   // already signalled
+        });
+    }
 
+    vector<epoll_event> events(1024);
     while (true) {
-        int client = accept(server_fd, nullptr, nullptr);
-        char buffer[4096]{};
-        read(client, buffer, sizeof(buffer));
-
-        string req(buffer);
-        stringstream ss(req);
-        string method, path;
-        ss >> method >> path;
-
-        auto q = parse_query(path);
-        string response;
-
-        if (path.find("/users") == 0) {
-            if (method == "POST")
-                response = create_user(q);
-            else if (method == "GET") {
-                if (q.count("id"))
-                    response = get_user(stoi(q["id"]));
-                else
-                    response = list_users();
+        int n = epoll_wait(w.epfd, events.data(), events.size(),
+                           ready_conns.empty() ? -1 : 0);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("epoll_wait");
+            return;
+        }
+
+        for (int i = 0; i < n; i++) {
+            int fd = events[i].data.fd;
+
+            if (fd == w.wake_fd) {
+                uint64_t count;
+                while (read(w.wake_fd, &count, sizeof(count)) > 0) {}
+                release_held(w);
+                continue;
             }
-            else if (method == "PUT")
-                response = update_user(stoi(q["id"]), q);
-            else if (method == "DELETE")
-                response = delete_user(stoi(q["id"]));
-            else
-                response = "Unsupported method";
-        } else {
-            response = "Not found";
+
+            if (fd == w.listen_fd) {
+                // accept everything that is waiting
+                while (true) {
+                    int client = accept4(w.listen_fd, nullptr, nullptr,
+                                         SOCK_NONBLOCK);
+                    if (client < 0) break;
+                    setsockopt(client, IPPROTO_TCP, TCP_NODELAY,
+                               &one, sizeof(one));
+
+                    epoll_event cev{};
+                    cev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+                    cev.data.fd = client;
+                    epoll_ctl(w.epfd, EPOLL_CTL_ADD, client, &cev);
+                    w.conns[client].fd = client;
+                    if (metrics_on) thread_metrics->conns_opened.add(1);
+                }
+                continue;
+            }
+
+            auto found = w.conns.find(fd);
+            if (found == w.conns.end()) continue;
+            Conn& c = found->second;
+
+            bool alive = true;
+            if (events[i].events & (EPOLLERR | EPOLLHUP))
+                alive = false;
+
+            if (alive && (events[i].events & (EPOLLIN | EPOLLRDHUP)))
+                alive = read_input(c);
+
+            if (alive) alive = pump(c);
+
+            if (!alive) close_conn(w, fd);
+        }
+        resume_ready(w);
+    }
+}
+
+/*
+ usage: ./test-server [port] [threads] [-D dir] [-m mode] [-w ms] [-s secs]
+                     [-M on|off]
+   threads  defaults to the number of cores
+   -D dir   keep users on disk in dir (log + snapshots), off by default
+   -m mode  none | group | sync      (default group)
+   -w ms    group commit window      (default 10)
+   -s secs  snapshot interval        (default 60)
+   -M off   disable /metrics collection (to measure its overhead)
+*/
+int main(int argc, char** argv) {
+    int port = argc > 1 ? atoi(argv[1]) : 8080;
+    int threads = argc > 2 ? atoi(argv[2])
+                           : (int)thread::hardware_concurrency();
+    threads = max(1, threads);
+
+    string data_dir;
+    Durability mode = Durability::GROUP;
+    int window_ms = 10;
+    int snapshot_secs = 60;
+    for (int i = 3; i + 1 < argc; i += 2) {
+        string f = argv[i];
+        string v = argv[i + 1];
+        if (f == "-D") data_dir = v;
+        else if (f == "-w") window_ms = max(1, stoi(v));
+        else if (f == "-s") snapshot_secs = max(1, stoi(v));
+        else if (f == "-M") metrics_on = v != "off";
+        else if (f == "-m") {
+            if (v == "none") mode = Durability::NONE;
+            else if (v == "sync") mode = Durability::SYNC;
+            else mode = Durability::GROUP;
         }
+    }
+
+    signal(SIGPIPE, SIG_IGN);
 
-        string http = http_response(response);
-        write(client, http.c_str(), http.size());
-        close(client);
+    if (!data_dir.empty()) {
+        mkdir(data_dir.c_str(), 0755);
+        uint64_t seg = recover(data_dir);
+        wal = make_unique<Wal>(data_dir, seg, mode, window_ms);
+        thread(snapshot_loop, data_dir, snapshot_secs).detach();
     }
+
+    vector<Worker> workers(threads);
+    for (int i = 0; i < threads; i++) {
+        workers[i].index = i;
+        workers[i].listen_fd = open_listener(port);
+    }
+
+    cout << "Server running on port " << port
+         << " with " << threads << " worker thread(s)\n";
+
+    vector<thread> pool;
+    for (int i = 1; i < threads; i++)
+        pool.emplace_back(run_worker, ref(workers[i]));
+    run_worker(workers[0]);
+
+    for (auto& t : pool) t.join();
 }
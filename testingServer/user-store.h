@@ -0,0 +1,133 @@
+#pragma once
+#include <bits/stdc++.h>
+
+/*
+========================================
+ USER STORE
+----------------------------------------
+ - slab   : every User sits in one contiguous vector
+ - free   : slots of deleted users, reused by the next insert
+ - index  : open addressing hash (linear probing) id -> slot
+
+ get / update / delete / insert -> O(1) average
+ for_each walks the slab front to back (cache friendly)
+
+ id 0 is never a valid user id, it marks empty index buckets
+ and free slab slots.
+========================================
+*/
+
+struct User {
+    int id;
+    std::string name;
+};
+
+class UserStore {
+public:
+    UserStore() { rehash(16); }
+
+    size_t size() const { return count; }
+
+    User* find(int id) {
+        if (id == 0) return nullptr;
+        size_t b = bucket_of(id);
+        while (index[b].id != 0) {
+            if (index[b].id == id) return &slab[index[b].slot];
+            b = (b + 1) & mask;
+        }
+        return nullptr;
+    }
+
+    // false if the id is already taken
+    bool insert(int id, std::string name) {
+        if (id == 0 || find(id)) return false;
+        if ((count + 1) * 10 > index.size() * 7) rehash(index.size() * 2);
+
+        uint32_t slot;
+        if (!free_slots.empty()) {
+            slot = free_slots.back();
+            free_slots.pop_back();
+            slab[slot] = {id, std::move(name)};
+        } else {
+            slot = (uint32_t)slab.size();
+            slab.push_back({id, std::move(name)});
+        }
+
+        size_t b = bucket_of(id);
+        while (index[b].id != 0) b = (b + 1) & mask;
+        index[b] = {id, slot};
+        count++;
+        return true;
+    }
+
+    bool erase(int id) {
+        if (id == 0) return false;
+        size_t b = bucket_of(id);
+        while (index[b].id != id) {
+            if (index[b].id == 0) return false;
+            b = (b + 1) & mask;
+        }
+
+        uint32_t slot = index[b].slot;
+        slab[slot].id = 0;
+        slab[slot].name.clear();
+        free_slots.push_back(slot);
+        count--;
+
+        // backward shift delete: pull later entries of the probe run
+        // into the hole so lookups never need tombstones
+        size_t hole = b;
+        size_t next = (b + 1) & mask;
+        while (index[next].id != 0) {
+            size_t home = bucket_of(index[next].id);
+            // move it if its home is not inside (hole, next]
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                index[hole] = index[next];
+                hole = next;
+            }
+            next = (next + 1) & mask;
+        }
+        index[hole] = {0, 0};
+        return true;
+    }
+
+    // f(const User&) for every live user, in slab order
+    template <class F>
+    void for_each(F f) const {
+        for (auto& u : slab)
+            if (u.id != 0) f(u);
+    }
+
+private:
+    struct Bucket {
+        int id;
+        uint32_t slot;
+    };
+
+    std::vector<User> slab;
+    std::vector<uint32_t> free_slots;
+    std::vector<Bucket> index;
+    size_t mask = 0;
+    int shift = 0;
+    size_t count = 0;
+
+    // Fibonacci hashing: top bits of id * 2^64/phi
+    size_t bucket_of(int id) const {
+        return (size_t)(((uint64_t)(uint32_t)id * 0x9E3779B97F4A7C15ull) >>
+                        shift);
+    }
+
+    void rehash(size_t buckets) {
+        index.assign(buckets, {0, 0});
+        mask = buckets - 1;
+        shift = 64 - __builtin_ctzll(buckets);
+
+        for (uint32_t slot = 0; slot < slab.size(); slot++) {
+            int id = slab[slot].id;
+            if (id == 0) continue;
+            size_t b = bucket_of(id);
+            while (index[b].id != 0) b = (b + 1) & mask;
+            index[b] = {id, slot};
+        }
+    }
+};